@@ -0,0 +1,214 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__MESSAGE_QUEUE_H__)
+#define __MESSAGE_QUEUE_H__
+
+#include "Defines.h"
+#include "Log.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define MESSAGE_QUEUE_CACHE_LINE 64U
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+//      Implements a lock-free single-producer/single-consumer queue of
+//      variable-length messages. Each message is stored as a 32-bit length
+//      followed by its payload in a power-of-two byte ring; the producer only
+//      writes the head index and the consumer only writes the tail index, so
+//      one thread may push while another pops without a lock.
+// ---------------------------------------------------------------------------
+
+class HOST_SW_API MessageQueue {
+public:
+    /// <summary>Initializes a new instance of the MessageQueue class.</summary>
+    /// <param name="capacity">Capacity of the queue in bytes; rounded up to a power of two.</param>
+    /// <param name="name">Name of queue.</param>
+    MessageQueue(uint32_t capacity, const char* name) :
+        m_head(0U),
+        m_tail(0U),
+        m_capacity(1U),
+        m_mask(0U),
+        m_buffer(nullptr),
+        m_name(name)
+    {
+        assert(capacity > 0U);
+        assert(name != nullptr);
+
+        while (m_capacity < capacity)
+            m_capacity <<= 1;
+        m_mask = m_capacity - 1U;
+
+        m_buffer = new uint8_t[m_capacity];
+    }
+
+    /// <summary>Finalizes a instance of the MessageQueue class.</summary>
+    ~MessageQueue()
+    {
+        delete[] m_buffer;
+    }
+
+    /// <summary>Adds a message to the end of the queue.</summary>
+    /// <remarks>May only be called from the producer thread.</remarks>
+    /// <param name="data">Message data.</param>
+    /// <param name="length">Length of the message.</param>
+    /// <returns>True, if the message is added to the queue, otherwise false.</returns>
+    bool push(const uint8_t* data, uint32_t length)
+    {
+        assert(data != nullptr);
+
+        uint32_t head = m_head.load(std::memory_order_relaxed);
+        uint32_t tail = m_tail.load(std::memory_order_acquire);
+
+        uint32_t needed = sizeof(uint32_t) + length;
+        uint32_t free = m_capacity - (head - tail);
+        if (needed > free) {
+            LogError(LOG_HOST, "%s queue overflow, dropping message. (%u > %u)", m_name, needed, free);
+            return false;
+        }
+
+        copyIn(head, (const uint8_t*)&length, sizeof(uint32_t));
+        copyIn(head + sizeof(uint32_t), data, length);
+
+        m_head.store(head + needed, std::memory_order_release);
+        return true;
+    }
+
+    /// <summary>Removes the next message from the queue.</summary>
+    /// <remarks>May only be called from the consumer thread.</remarks>
+    /// <param name="buffer">Buffer to copy the message to.</param>
+    /// <param name="size">Size of the buffer.</param>
+    /// <param name="length">Length of the message.</param>
+    /// <returns>True, if a message is read from the queue, otherwise false.</returns>
+    bool pop(uint8_t* buffer, uint32_t size, uint32_t& length)
+    {
+        assert(buffer != nullptr);
+
+        uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        uint32_t head = m_head.load(std::memory_order_acquire);
+        if (head == tail)
+            return false;
+
+        copyOut(tail, (uint8_t*)&length, sizeof(uint32_t));
+        if (length > size) {
+            LogError(LOG_HOST, "%s queue message too large, dropping message. (%u > %u)", m_name, length, size);
+            m_tail.store(tail + sizeof(uint32_t) + length, std::memory_order_release);
+            length = 0U;
+            return false;
+        }
+
+        copyOut(tail + sizeof(uint32_t), buffer, length);
+
+        m_tail.store(tail + sizeof(uint32_t) + length, std::memory_order_release);
+        return true;
+    }
+
+    /// <summary>Discards all messages in the queue.</summary>
+    /// <remarks>May only be called from the consumer thread.</remarks>
+    void clear()
+    {
+        m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    /// <summary>Returns the number of bytes, including message lengths, currently queued.</summary>
+    /// <returns>Size of data stored in the queue.</returns>
+    uint32_t dataSize() const
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    /// <summary>Gets the capacity of the queue in bytes.</summary>
+    /// <returns>Capacity of the queue.</returns>
+    uint32_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    /// <summary>Helper to return whether the queue contains messages.</summary>
+    /// <returns>True, if the queue contains messages, otherwise false.</returns>
+    bool hasData() const
+    {
+        return m_head.load(std::memory_order_acquire) != m_tail.load(std::memory_order_relaxed);
+    }
+
+    /// <summary>Helper to return whether the queue is empty or not.</summary>
+    /// <returns>True, if the queue is empty, otherwise false.</returns>
+    bool isEmpty() const
+    {
+        return !hasData();
+    }
+
+private:
+    // the indices run freely and are masked on access; each sits on its own cache
+    // line so the producer and consumer do not contend for the same line
+    alignas(MESSAGE_QUEUE_CACHE_LINE) std::atomic<uint32_t> m_head;
+    alignas(MESSAGE_QUEUE_CACHE_LINE) std::atomic<uint32_t> m_tail;
+
+    // the read-only ring description gets a line of its own, so neither index
+    // store invalidates it for the other thread
+    alignas(MESSAGE_QUEUE_CACHE_LINE) uint32_t m_capacity;
+    uint32_t m_mask;
+
+    uint8_t* m_buffer;
+
+    const char* m_name;
+
+    /// <summary>Copies data into the ring at the given index, wrapping as needed.</summary>
+    void copyIn(uint32_t index, const uint8_t* data, uint32_t length)
+    {
+        uint32_t offset = index & m_mask;
+        uint32_t first = m_capacity - offset;
+        if (first >= length) {
+            ::memcpy(m_buffer + offset, data, length);
+        }
+        else {
+            ::memcpy(m_buffer + offset, data, first);
+            ::memcpy(m_buffer, data + first, length - first);
+        }
+    }
+
+    /// <summary>Copies data out of the ring at the given index, wrapping as needed.</summary>
+    void copyOut(uint32_t index, uint8_t* data, uint32_t length) const
+    {
+        uint32_t offset = index & m_mask;
+        uint32_t first = m_capacity - offset;
+        if (first >= length) {
+            ::memcpy(data, m_buffer + offset, length);
+        }
+        else {
+            ::memcpy(data, m_buffer + offset, first);
+            ::memcpy(data + first, m_buffer, length - first);
+        }
+    }
+};
+
+#endif // __MESSAGE_QUEUE_H__
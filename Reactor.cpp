@@ -0,0 +1,265 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "Reactor.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define MAX_EVENTS 16
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+/// <summary>
+/// Initializes a new instance of the Reactor class.
+/// </summary>
+Reactor::Reactor() :
+    m_epollFd(-1),
+    m_timerFd(-1),
+    m_eventFd(-1),
+    m_fds()
+{
+    /* stub */
+}
+
+/// <summary>
+/// Finalizes a instance of the Reactor class.
+/// </summary>
+Reactor::~Reactor()
+{
+    close();
+}
+
+#if defined(__linux__)
+/// <summary>
+/// Opens the reactor.
+/// </summary>
+/// <returns>True, if the reactor was opened, otherwise false.</returns>
+bool Reactor::open()
+{
+    if (m_epollFd >= 0)
+        return true;
+
+    m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (m_epollFd < 0) {
+        LogError(LOG_HOST, "Cannot create epoll instance, err: %d", errno);
+        close();
+        return false;
+    }
+
+    m_timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (m_timerFd < 0) {
+        LogError(LOG_HOST, "Cannot create timerfd, err: %d", errno);
+        close();
+        return false;
+    }
+
+    m_eventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_eventFd < 0) {
+        LogError(LOG_HOST, "Cannot create eventfd, err: %d", errno);
+        close();
+        return false;
+    }
+
+    int fds[] = { m_timerFd, m_eventFd };
+    for (int fd : fds) {
+        struct epoll_event ev;
+        ::memset(&ev, 0x00U, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+
+        if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            LogError(LOG_HOST, "Cannot add descriptor to epoll, err: %d", errno);
+            close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// <summary>
+/// Closes the reactor.
+/// </summary>
+void Reactor::close()
+{
+    if (m_eventFd >= 0) {
+        ::close(m_eventFd);
+        m_eventFd = -1;
+    }
+
+    if (m_timerFd >= 0) {
+        ::close(m_timerFd);
+        m_timerFd = -1;
+    }
+
+    if (m_epollFd >= 0) {
+        ::close(m_epollFd);
+        m_epollFd = -1;
+    }
+
+    m_fds.clear();
+}
+
+/// <summary>
+/// Sets the descriptors watched for readability.
+/// </summary>
+/// <remarks>Descriptors that are no longer present are removed from the reactor; this
+/// is called every loop to follow sockets that are closed and reopened.</remarks>
+/// <param name="fds"></param>
+void Reactor::setFds(const std::vector<int>& fds)
+{
+    if (m_epollFd < 0)
+        return;
+
+    for (int fd : m_fds) {
+        if (std::find(fds.begin(), fds.end(), fd) == fds.end()) {
+            // the descriptor may already have been closed (which removes it from epoll)
+            ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        }
+    }
+
+    for (int fd : fds) {
+        struct epoll_event ev;
+        ::memset(&ev, 0x00U, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+
+        // a socket that was closed and reopened may come back with the same descriptor
+        // number but is no longer registered, so always (re)register
+        if (::epoll_ctl(m_epollFd, EPOLL_CTL_MOD, fd, &ev) < 0 && errno == ENOENT) {
+            ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &ev);
+        }
+    }
+
+    m_fds = fds;
+}
+
+/// <summary>
+/// Waits for a watched descriptor, the deadline or a wakeup.
+/// </summary>
+/// <param name="timeout">Maximum amount of time (in milliseconds) to wait; zero returns immediately.</param>
+void Reactor::wait(uint32_t timeout)
+{
+    if (m_epollFd < 0)
+        return;
+
+    struct itimerspec spec;
+    ::memset(&spec, 0x00U, sizeof(spec));
+    spec.it_value.tv_sec = timeout / 1000U;
+    spec.it_value.tv_nsec = (timeout % 1000U) * 1000000L;
+
+    // a zero it_value disarms the timer, so a zero timeout polls instead
+    int waitMs = -1;
+    if (timeout == 0U) {
+        waitMs = 0;
+    }
+
+    ::timerfd_settime(m_timerFd, 0, &spec, nullptr);
+
+    struct epoll_event events[MAX_EVENTS];
+    int n = ::epoll_wait(m_epollFd, events, MAX_EVENTS, waitMs);
+    for (int i = 0; i < n; i++) {
+        int fd = events[i].data.fd;
+        if (fd == m_timerFd || fd == m_eventFd) {
+            // drain the counter so the descriptor is no longer readable
+            uint64_t value = 0U;
+            ssize_t ret = ::read(fd, &value, sizeof(value));
+            (void)ret;
+        }
+    }
+}
+
+/// <summary>
+/// Wakes the reactor from another thread.
+/// </summary>
+void Reactor::wake()
+{
+    if (m_eventFd < 0)
+        return;
+
+    uint64_t value = 1U;
+    ssize_t ret = ::write(m_eventFd, &value, sizeof(value));
+    (void)ret;
+}
+#else
+/// <summary>
+/// Opens the reactor.
+/// </summary>
+/// <returns>Always false; the reactor is not supported on this platform.</returns>
+bool Reactor::open()
+{
+    return false;
+}
+
+/// <summary>
+/// Closes the reactor.
+/// </summary>
+void Reactor::close()
+{
+    m_fds.clear();
+}
+
+/// <summary>
+/// Sets the descriptors watched for readability.
+/// </summary>
+/// <param name="fds"></param>
+void Reactor::setFds(const std::vector<int>& fds)
+{
+    m_fds = fds;
+}
+
+/// <summary>
+/// Waits for a watched descriptor, the deadline or a wakeup.
+/// </summary>
+/// <param name="timeout"></param>
+void Reactor::wait(uint32_t timeout)
+{
+    /* stub */
+}
+
+/// <summary>
+/// Wakes the reactor from another thread.
+/// </summary>
+void Reactor::wake()
+{
+    /* stub */
+}
+#endif
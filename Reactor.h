@@ -0,0 +1,76 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__REACTOR_H__)
+#define __REACTOR_H__
+
+#include "Defines.h"
+
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+//      Implements a simple event reactor for the host loop. The reactor
+//      sleeps until one of the watched descriptors becomes readable, the
+//      armed deadline passes or another thread calls wake().
+//
+//      This is only implemented on Linux (epoll, timerfd and eventfd); on
+//      other platforms open() fails and the caller should fall back to
+//      polling.
+// ---------------------------------------------------------------------------
+
+class HOST_SW_API Reactor {
+public:
+    /// <summary>Initializes a new instance of the Reactor class.</summary>
+    Reactor();
+    /// <summary>Finalizes a instance of the Reactor class.</summary>
+    ~Reactor();
+
+    /// <summary>Opens the reactor.</summary>
+    bool open();
+    /// <summary>Closes the reactor.</summary>
+    void close();
+
+    /// <summary>Sets the descriptors watched for readability.</summary>
+    void setFds(const std::vector<int>& fds);
+
+    /// <summary>Waits for a watched descriptor, the deadline or a wakeup.</summary>
+    void wait(uint32_t timeout);
+
+    /// <summary>Wakes the reactor from another thread.</summary>
+    void wake();
+
+    /// <summary>Helper to return whether the reactor is open.</summary>
+    bool isOpen() const { return m_epollFd >= 0; }
+
+private:
+    int m_epollFd;
+    int m_timerFd;
+    int m_eventFd;
+
+    std::vector<int> m_fds;
+};
+
+#endif // __REACTOR_H__
@@ -68,6 +68,34 @@ public:
         return (m_timeout - m_timer) / m_ticksPerSec;
     }
 
+    /// <summary>Gets the currently remaining time for the timer, in milliseconds.</summary>
+    /// <returns>Amount of time (in milliseconds) remaining before the timeout, or zero if the timer
+    /// is stopped, paused or has already expired.</returns>
+    uint32_t getRemainingMs()
+    {
+        if (m_timeout == 0U || m_timer == 0U || m_paused)
+            return 0U;
+
+        if (m_timer >= m_timeout)
+            return 0U;
+
+        return (uint32_t)(((ulong64_t)(m_timeout - m_timer) * 1000ULL) / m_ticksPerSec);
+    }
+
+    /// <summary>Helper to return the earliest of two deadlines, where zero indicates no deadline.</summary>
+    /// <param name="a"></param>
+    /// <param name="b"></param>
+    /// <returns></returns>
+    static uint32_t earliest(uint32_t a, uint32_t b)
+    {
+        if (a == 0U)
+            return b;
+        if (b == 0U)
+            return a;
+
+        return (a < b) ? a : b;
+    }
+
     /// <summary>Flag indicating whether the timer is running.</summary>
     /// <returns>True, if the timer is still running, otherwise false.</returns>
     bool isRunning()
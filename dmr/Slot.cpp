@@ -40,11 +40,79 @@ using namespace dmr;
 #include <cmath>
 
 // ---------------------------------------------------------------------------
-//  Static Class Members
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t VOICE_JOB_COUNT = 16U;
+
 // ---------------------------------------------------------------------------
+//  Class Declaration
+//      Represents the vocoder work for a single DMR voice burst (3 AMBE
+//      codewords to 3 IMBE codewords), or a marker for the end of the call.
+// ---------------------------------------------------------------------------
+
+class Slot::VoiceJob : public vocoder::VocoderJob {
+public:
+    /// <summary>Initializes a new instance of the VoiceJob class.</summary>
+    VoiceJob(vocoder::VocoderContext* context) :
+        m_terminator(false),
+        m_newCall(false),
+        m_srcId(0U),
+        m_dstId(0U),
+        m_group(false),
+        m_context(context)
+    {
+        ::memset(m_ambe, 0x00U, sizeof(m_ambe));
+        ::memset(m_imbe, 0x00U, sizeof(m_imbe));
+        ::memset(m_errs, 0x00U, sizeof(m_errs));
+    }
 
-vocoder::MBEDecoder* Slot::m_mbeDecode = nullptr;
-vocoder::MBEEncoder* Slot::m_mbeEncode = nullptr;
+    /// <summary>Prepares a recycled job for reuse.</summary>
+    void init()
+    {
+        m_terminator = false;
+        m_newCall = false;
+        m_srcId = 0U;
+        m_dstId = 0U;
+        m_group = false;
+    }
+
+    /// <summary>Transcodes the AMBE codewords into IMBE codewords.</summary>
+    void process()
+    {
+        if (m_terminator) {
+            m_context->finishCall();
+            return;
+        }
+
+        // a new call starts from the initial vocoder state rather than the tail of the last one
+        if (m_newCall) {
+            m_context->reset();
+        }
+
+        for (uint8_t n = 0; n < AMBE_PER_SLOT; n++) {
+            m_errs[n] = m_context->transcode(m_ambe + (n * 9U), m_imbe + (n * 11U));
+        }
+    }
+
+    bool m_terminator;
+    bool m_newCall;
+
+    uint32_t m_srcId;
+    uint32_t m_dstId;
+    bool m_group;
+
+    uint8_t m_ambe[AMBE_PER_SLOT * 9U];
+    uint8_t m_imbe[AMBE_PER_SLOT * 11U];
+    int32_t m_errs[AMBE_PER_SLOT];
+
+private:
+    vocoder::VocoderContext* m_context;
+};
+
+// ---------------------------------------------------------------------------
+//  Static Class Members
+// ---------------------------------------------------------------------------
 
 uint32_t Slot::m_jitterTime = 360U;
 uint32_t Slot::m_jitterSlots = 6U;
@@ -67,10 +135,15 @@ bool Slot::m_voice2 = true;
 /// <param name="slotNo">DMR slot number.</param>
 /// <param name="network">Instance of the BaseNetwork class representing the source network.</param>
 /// <param name="network">Instance of the BaseNetwork class representing the destination network.</param>
+/// <param name="vocoderPool">Instance of the VocoderPool class to run vocoder work on.</param>
 /// <param name="timeout">Transmit timeout.</param>
+/// <param name="gainAdjust"></param>
+/// <param name="transcodeMode">Vocoder transcode mode.</param>
+/// <param name="compare">Flag indicating whether the vocoder A/B comparison is enabled.</param>
+/// <param name="floatFFT">Flag indicating whether speech analysis uses the float FFT.</param>
 /// <param name="debug">Flag indicating whether DMR debug is enabled.</param>
 /// <param name="verbose">Flag indicating whether DMR verbose logging is enabled.</param>
-Slot::Slot(uint32_t slotNo, network::BaseNetwork* srcNetwork, network::BaseNetwork* dstNetwork, uint32_t timeout, bool debug, bool verbose) :
+Slot::Slot(uint32_t slotNo, network::BaseNetwork* srcNetwork, network::BaseNetwork* dstNetwork, vocoder::VocoderPool* vocoderPool, uint32_t timeout, float gainAdjust, vocoder::TRANSCODE_MODE transcodeMode, bool compare, bool floatFFT, bool debug, bool verbose) :
     m_slotNo(slotNo),
     m_netState(RS_NET_IDLE),
     m_networkWatchdog(1000U, 0U, 1500U),
@@ -94,6 +167,12 @@ Slot::Slot(uint32_t slotNo, network::BaseNetwork* srcNetwork, network::BaseNetwo
     m_fec(),
     m_srcNetwork(srcNetwork),
     m_dstNetwork(dstNetwork),
+    m_vocoderContext(nullptr),
+    m_vocoder(nullptr),
+    m_voiceJobs(nullptr),
+    m_voiceJobNext(0U),
+    m_voiceJobsInUse(0U),
+    m_newCallPending(false),
     m_verbose(verbose),
     m_debug(debug)
 {
@@ -107,6 +186,15 @@ Slot::Slot(uint32_t slotNo, network::BaseNetwork* srcNetwork, network::BaseNetwo
 
     ::memset(m_netLDU1, 0x00U, 9U * 25U);
     ::memset(m_netLDU2, 0x00U, 9U * 25U);
+
+    m_vocoderContext = new vocoder::VocoderContext(vocoder::DECODE_DMR_AMBE, vocoder::ENCODE_88BIT_IMBE, gainAdjust, transcodeMode, compare, floatFFT);
+    m_vocoder = new vocoder::VocoderChannel(vocoderPool);
+
+    // voice jobs are recycled through a fixed ring so the voice path never allocates
+    m_voiceJobs = new VoiceJob*[VOICE_JOB_COUNT];
+    for (uint32_t i = 0U; i < VOICE_JOB_COUNT; i++) {
+        m_voiceJobs[i] = new VoiceJob(m_vocoderContext);
+    }
 }
 
 /// <summary>
@@ -114,6 +202,14 @@ Slot::Slot(uint32_t slotNo, network::BaseNetwork* srcNetwork, network::BaseNetwo
 /// </summary>
 Slot::~Slot()
 {
+    delete m_vocoder;
+
+    for (uint32_t i = 0U; i < VOICE_JOB_COUNT; i++) {
+        delete m_voiceJobs[i];
+    }
+
+    delete[] m_voiceJobs;
+    delete m_vocoderContext;
     delete[] m_netLDU1;
     delete[] m_netLDU2;
 }
@@ -255,13 +351,7 @@ void Slot::processNetwork(const data::Data& dmrData)
         m_netErrs = 0U;
         m_netBits = 1U;
 
-        m_dstNetwork->writeP25TDU(m_p25LC, m_p25LSD);
-
-        m_p25LC.reset();
-        m_p25N = 0U;
-
-        ::memset(m_netLDU1, 0x00U, 9U * 25U);
-        ::memset(m_netLDU2, 0x00U, 9U * 25U);
+        queueNet_P25_TDU();
         break;
     }
 
@@ -320,13 +410,7 @@ void Slot::clock()
             m_netErrs = 0U;
             m_netBits = 1U;
 
-            m_dstNetwork->writeP25TDU(m_p25LC, m_p25LSD);
-
-            m_p25LC.reset();
-            m_p25N = 0U;
-
-            ::memset(m_netLDU1, 0x00U, 9U * 25U);
-            ::memset(m_netLDU2, 0x00U, 9U * 25U);
+            queueNet_P25_TDU();
         }
     }
 
@@ -344,19 +428,47 @@ void Slot::clock()
             m_packetTimer.start();
         }
     }
+
+    // write P25 frames for any completed vocoder work
+    vocoder::VocoderJob* job = nullptr;
+    while ((job = m_vocoder->getCompleted()) != nullptr) {
+        VoiceJob* voice = static_cast<VoiceJob*>(job);
+        if (voice->m_terminator) {
+            writeNet_P25_TDU();
+        }
+        else {
+            writeNet_P25_Voice(*voice);
+        }
+
+        m_voiceJobsInUse--;
+    }
+}
+
+/// <summary>
+/// Gets the number of milliseconds until the next slot timer expires.
+/// </summary>
+/// <returns>Milliseconds until the next deadline, or zero if nothing is pending.</returns>
+uint32_t Slot::getNextDeadline()
+{
+    uint32_t deadline = 0U;
+    if (!m_netTimeout) {
+        deadline = m_netTimeoutTimer.getRemainingMs();
+    }
+
+    if (m_netState == RS_NET_AUDIO) {
+        deadline = Timer::earliest(deadline, m_networkWatchdog.getRemainingMs());
+        deadline = Timer::earliest(deadline, m_packetTimer.getRemainingMs());
+    }
+
+    return deadline;
 }
 
 /// <summary>
 /// Helper to initialize the DMR slot processor.
 /// </summary>
 /// <param name="jitter"></param>
-/// <param name="gainAdjust"></param>
-void Slot::init(uint32_t jitter, float gainAdjust)
+void Slot::init(uint32_t jitter)
 {
-    m_mbeDecode = new vocoder::MBEDecoder(vocoder::DECODE_DMR_AMBE);
-    m_mbeEncode = new vocoder::MBEEncoder(vocoder::ENCODE_88BIT_IMBE);
-    m_mbeEncode->setGainAdjust(gainAdjust);
-
     m_jitterTime = jitter;
 
     float jitter_tmp = float(jitter) / 360.0F;
@@ -380,18 +492,38 @@ void Slot::decodeAndProcessAMBE(uint8_t* ambe)
 {
     if (m_netState == RS_NET_IDLE) {
         m_netState = RS_NET_AUDIO;
+        m_newCallPending = true;
+    }
+
+    // if the vocoder overran, the start of the call carries over to the next burst that gets a job
+    VoiceJob* job = acquireVoiceJob();
+    if (job == nullptr)
+        return;
 
+    job->m_newCall = m_newCallPending;
+    m_newCallPending = false;
+
+    job->m_srcId = m_netLC->getSrcId();
+    job->m_dstId = m_netLC->getDstId();
+    job->m_group = m_netLC->getFLCO() == FLCO_GROUP;
+
+    ::memcpy(job->m_ambe, ambe, AMBE_PER_SLOT * 9U);
+
+    m_vocoder->submit(job);
+}
+
+/// <summary>
+/// Helper to write P25 LDUs for a completed vocoder job.
+/// </summary>
+/// <param name="job"></param>
+void Slot::writeNet_P25_Voice(const VoiceJob& job)
+{
+    if (job.m_newCall) {
         // setup P25 LC data
         p25::lc::LC lc;
-        lc.setSrcId(m_netLC->getSrcId());
-        lc.setDstId(m_netLC->getDstId());
-
-        if (m_netLC->getFLCO() == FLCO_GROUP) {
-            lc.setGroup(true);
-        }
-        else {
-            lc.setGroup(false);
-        }
+        lc.setSrcId(job.m_srcId);
+        lc.setDstId(job.m_dstId);
+        lc.setGroup(job.m_group);
 
         m_p25LC = lc;
         m_p25N = 0U;
@@ -410,24 +542,11 @@ void Slot::decodeAndProcessAMBE(uint8_t* ambe)
     }
 
     for (uint8_t n = 0; n < AMBE_PER_SLOT; n++) {
-        // decode AMBE into PCM
-        int16_t pcmSamples[160U];
-        ::memset(pcmSamples, 0x00U, 160U);
-
-        uint8_t ambePartial[9U];
-        ::memset(ambePartial, 0x00U, 9U);
-        ::memcpy(ambePartial, ambe + (n * 9U), 9U);
-
-        int32_t errs = m_mbeDecode->decode(ambePartial, pcmSamples);
         if (m_debug) {
-            LogDebug(LOG_DMR, "decoded AMBE VC%u, errs = %u", n, errs);
+            LogDebug(LOG_DMR, "decoded AMBE VC%u, errs = %u", n, job.m_errs[n]);
         }
 
-        // encode PCM into IMBE
-        uint8_t imbe[11U];
-        ::memset(imbe, 0x00U, 11U);
-
-        m_mbeEncode->encode(pcmSamples, imbe);
+        const uint8_t* imbe = job.m_imbe + (n * 11U);
 
         switch (m_p25N) {
             // LDU1
@@ -511,3 +630,67 @@ void Slot::decodeAndProcessAMBE(uint8_t* ambe)
         m_p25N++;
     }
 }
+
+/// <summary>
+/// Helper to queue a P25 TDU behind any outstanding vocoder jobs.
+/// </summary>
+void Slot::queueNet_P25_TDU()
+{
+    // a call whose audio never reached the vocoder put nothing on air to terminate
+    if (m_newCallPending) {
+        m_newCallPending = false;
+        return;
+    }
+
+    VoiceJob* job = acquireVoiceJob(true);
+    if (job == nullptr)
+        return;
+
+    job->m_terminator = true;
+
+    m_vocoder->submit(job);
+}
+
+/// <summary>
+/// Helper to write a P25 TDU and reset the P25 call state.
+/// </summary>
+void Slot::writeNet_P25_TDU()
+{
+    m_dstNetwork->writeP25TDU(m_p25LC, m_p25LSD);
+
+    m_p25LC.reset();
+    m_p25N = 0U;
+
+    ::memset(m_netLDU1, 0x00U, 9U * 25U);
+    ::memset(m_netLDU2, 0x00U, 9U * 25U);
+}
+
+/// <summary>
+/// Helper to take the next free voice job from the voice job ring.
+/// </summary>
+/// <param name="terminator">Flag indicating the job ends the call and may take the job kept back for it.</param>
+/// <returns>Recycled voice job, or nullptr if every job is still with the vocoder.</returns>
+Slot::VoiceJob* Slot::acquireVoiceJob(bool terminator)
+{
+    // jobs come back from the vocoder in submission order, so the ring only has to
+    // track how many are outstanding; audio always leaves the last job free, so once a
+    // call has audio in the vocoder its TDU is guaranteed a job behind it
+    uint32_t available = terminator ? VOICE_JOB_COUNT : VOICE_JOB_COUNT - 1U;
+    if (m_voiceJobsInUse >= available) {
+        if (terminator) {
+            LogError(LOG_NET, "DMR Slot %u, vocoder overrun, %u voice jobs outstanding, dropping TDU", m_slotNo, m_voiceJobsInUse);
+        }
+        else {
+            LogWarning(LOG_NET, "DMR Slot %u, vocoder overrun, %u voice jobs outstanding, dropping audio", m_slotNo, m_voiceJobsInUse);
+        }
+
+        return nullptr;
+    }
+
+    VoiceJob* job = m_voiceJobs[m_voiceJobNext];
+    m_voiceJobNext = (m_voiceJobNext + 1U) % VOICE_JOB_COUNT;
+    m_voiceJobsInUse++;
+
+    job->init();
+    return job;
+}
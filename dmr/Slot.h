@@ -37,8 +37,8 @@
 #include "edac/AMBEFEC.h"
 #include "p25/lc/LC.h"
 #include "network/BaseNetwork.h"
-#include "vocoder/MBEDecoder.h"
-#include "vocoder/MBEEncoder.h"
+#include "vocoder/VocoderContext.h"
+#include "vocoder/VocoderPool.h"
 #include "RingBuffer.h"
 #include "StopWatch.h"
 #include "Timer.h"
@@ -60,7 +60,7 @@ namespace dmr
     class HOST_SW_API Slot {
     public:
         /// <summary>Initializes a new instance of the Slot class.</summary>
-        Slot(uint32_t slotNo, network::BaseNetwork* srcNetwork, network::BaseNetwork* dstNetwork, uint32_t timeout, bool debug, bool verbose);
+        Slot(uint32_t slotNo, network::BaseNetwork* srcNetwork, network::BaseNetwork* dstNetwork, vocoder::VocoderPool* vocoderPool, uint32_t timeout, float gainAdjust, vocoder::TRANSCODE_MODE transcodeMode, bool compare, bool floatFFT, bool debug, bool verbose);
         /// <summary>Finalizes a instance of the Slot class.</summary>
         ~Slot();
 
@@ -70,11 +70,15 @@ namespace dmr
         /// <summary>Updates the slot processor.</summary>
         void clock();
 
+        /// <summary>Gets the number of milliseconds until the next slot timer expires.</summary>
+        uint32_t getNextDeadline();
+
         /// <summary>Helper to initialize the slot processor.</summary>
-        static void init(uint32_t jitter, float gainAdjust);
+        static void init(uint32_t jitter);
 
     private:
         friend class Transcode;
+        class VoiceJob;
 
         uint32_t m_slotNo;
 
@@ -110,12 +114,17 @@ namespace dmr
         network::BaseNetwork* m_srcNetwork;
         network::BaseNetwork* m_dstNetwork;
 
+        vocoder::VocoderContext* m_vocoderContext;
+        vocoder::VocoderChannel* m_vocoder;
+
+        VoiceJob** m_voiceJobs;
+        uint32_t m_voiceJobNext;
+        uint32_t m_voiceJobsInUse;
+        bool m_newCallPending;
+
         bool m_verbose;
         bool m_debug;
 
-        static vocoder::MBEDecoder* m_mbeDecode;
-        static vocoder::MBEEncoder* m_mbeEncode;
-
         static uint32_t m_jitterTime;
         static uint32_t m_jitterSlots;
 
@@ -131,6 +140,15 @@ namespace dmr
 
         /// <summary></summary>
         void decodeAndProcessAMBE(uint8_t* ambe);
+        /// <summary>Helper to write P25 LDUs for a completed vocoder job.</summary>
+        void writeNet_P25_Voice(const VoiceJob& job);
+        /// <summary>Helper to queue a P25 TDU behind any outstanding vocoder jobs.</summary>
+        void queueNet_P25_TDU();
+        /// <summary>Helper to write a P25 TDU and reset the P25 call state.</summary>
+        void writeNet_P25_TDU();
+
+        /// <summary>Helper to take the next free voice job from the voice job ring.</summary>
+        VoiceJob* acquireVoiceJob(bool terminator = false);
     };
 } // namespace dmr
 
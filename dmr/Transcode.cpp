@@ -41,12 +41,16 @@ using namespace dmr;
 /// </summary>
 /// <param name="network">Instance of the BaseNetwork class representing the source network.</param>
 /// <param name="network">Instance of the BaseNetwork class representing the destination network.</param>
+/// <param name="vocoderPool">Instance of the VocoderPool class to run vocoder work on.</param>
 /// <param name="timeout">Transmit timeout.</param>
 /// <param name="jitter"></param>
 /// <param name="gainAdjust"></param>
+/// <param name="transcodeMode">Vocoder transcode mode.</param>
+/// <param name="compare">Flag indicating whether the vocoder A/B comparison is enabled.</param>
+/// <param name="floatFFT">Flag indicating whether speech analysis uses the float FFT.</param>
 /// <param name="debug">Flag indicating whether DMR debug is enabled.</param>
 /// <param name="verbose">Flag indicating whether DMR verbose logging is enabled.</param>
-Transcode::Transcode(network::BaseNetwork* srcNetwork, network::BaseNetwork* dstNetwork, uint32_t timeout, uint32_t jitter, float gainAdjust, bool debug, bool verbose) :
+Transcode::Transcode(network::BaseNetwork* srcNetwork, network::BaseNetwork* dstNetwork, vocoder::VocoderPool* vocoderPool, uint32_t timeout, uint32_t jitter, float gainAdjust, vocoder::TRANSCODE_MODE transcodeMode, bool compare, bool floatFFT, bool debug, bool verbose) :
     m_srcNetwork(srcNetwork),
     m_dstNetwork(dstNetwork),
     m_slot1(nullptr),
@@ -57,10 +61,10 @@ Transcode::Transcode(network::BaseNetwork* srcNetwork, network::BaseNetwork* dst
     assert(srcNetwork != nullptr);
     assert(dstNetwork != nullptr);
 
-    Slot::init(jitter, gainAdjust);
+    Slot::init(jitter);
     
-    m_slot1 = new Slot(1U, srcNetwork, dstNetwork, timeout, debug, verbose);
-    m_slot2 = new Slot(2U, srcNetwork, dstNetwork, timeout, debug, verbose);
+    m_slot1 = new Slot(1U, srcNetwork, dstNetwork, vocoderPool, timeout, gainAdjust, transcodeMode, compare, floatFFT, debug, verbose);
+    m_slot2 = new Slot(2U, srcNetwork, dstNetwork, vocoderPool, timeout, gainAdjust, transcodeMode, compare, floatFFT, debug, verbose);
 }
 
 /// <summary>
@@ -78,9 +82,14 @@ Transcode::~Transcode()
 void Transcode::clock()
 {
     if (m_srcNetwork != nullptr) {
+        // consume every frame queued by the network; frames for disabled slots are
+        // dropped by readDMR()
         data::Data data;
-        bool ret = m_srcNetwork->readDMR(data);
-        if (ret) {
+        while (m_srcNetwork->hasDMRData()) {
+            bool ret = m_srcNetwork->readDMR(data);
+            if (!ret)
+                continue;
+
             uint32_t slotNo = data.getSlotNo();
             switch (slotNo) {
                 case 1U:
@@ -99,3 +108,12 @@ void Transcode::clock()
     m_slot1->clock();
     m_slot2->clock();
 }
+
+/// <summary>
+/// Gets the number of milliseconds until the next slot timer expires.
+/// </summary>
+/// <returns>Milliseconds until the next deadline, or zero if nothing is pending.</returns>
+uint32_t Transcode::getNextDeadline()
+{
+    return Timer::earliest(m_slot1->getNextDeadline(), m_slot2->getNextDeadline());
+}
@@ -35,6 +35,8 @@
 #include "dmr/data/Data.h"
 #include "dmr/Slot.h"
 #include "network/BaseNetwork.h"
+#include "vocoder/VocoderContext.h"
+#include "vocoder/VocoderPool.h"
 
 namespace dmr
 {
@@ -51,13 +53,18 @@ namespace dmr
     class HOST_SW_API Transcode {
     public:
         /// <summary>Initializes a new instance of the Transcode class.</summary>
-        Transcode(network::BaseNetwork* srcNetwork, network::BaseNetwork* dstNetwork, uint32_t timeout, uint32_t jitter, float gainAdjust, bool debug, bool verbose);
+        Transcode(network::BaseNetwork* srcNetwork, network::BaseNetwork* dstNetwork, vocoder::VocoderPool* vocoderPool, uint32_t timeout, uint32_t jitter, float gainAdjust, vocoder::TRANSCODE_MODE transcodeMode, bool compare, bool floatFFT, bool debug, bool verbose);
         /// <summary>Finalizes a instance of the Transcode class.</summary>
         ~Transcode();
 
         /// <summary>Updates the processor.</summary>
         void clock();
 
+        /// <summary>Gets the number of milliseconds until the next slot timer expires.</summary>
+        uint32_t getNextDeadline();
+        /// <summary>Helper to return whether network frames are waiting to be processed.</summary>
+        bool hasRxData() const { return m_srcNetwork->hasDMRData(); }
+
     private:
         network::BaseNetwork* m_srcNetwork;
         network::BaseNetwork* m_dstNetwork;
@@ -0,0 +1,135 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "dmr/TxQueue.h"
+#include "Log.h"
+
+using namespace dmr;
+
+#include <cassert>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+/// <summary>
+/// Initializes a new instance of the TxQueue class.
+/// </summary>
+/// <param name="network">Instance of the BaseNetwork class to write frames to.</param>
+/// <param name="interval">Amount of time (in milliseconds) between transmitted frames.</param>
+/// <param name="capacity">Maximum number of frames that may be waiting in the queue.</param>
+TxQueue::TxQueue(network::BaseNetwork* network, uint32_t interval, uint32_t capacity) :
+    m_network(network),
+    m_interval(interval),
+    m_now(0ULL),
+    m_nextTx(0ULL),
+    m_frames(nullptr),
+    m_capacity(capacity),
+    m_head(0U),
+    m_count(0U)
+{
+    assert(network != nullptr);
+    assert(capacity > 0U);
+
+    m_frames = new TxFrame[capacity];
+}
+
+/// <summary>
+/// Finalizes a instance of the TxQueue class.
+/// </summary>
+TxQueue::~TxQueue()
+{
+    delete[] m_frames;
+}
+
+/// <summary>
+/// Adds a DMR frame to the end of the transmit queue.
+/// </summary>
+/// <remarks>The first frame of a burst is due immediately, every frame after it is
+/// due one interval after the frame before it.</remarks>
+/// <param name="data">DMR frame to transmit.</param>
+/// <returns>True, if the frame was queued, otherwise false if the queue is full.</returns>
+bool TxQueue::enqueue(const data::Data& data)
+{
+    if (m_count == m_capacity) {
+        LogWarning(LOG_DMR, "transmit queue overrun, %u frames waiting, dropping frame", m_count);
+        return false;
+    }
+
+    ulong64_t deadline = m_nextTx;
+    if (deadline < m_now)
+        deadline = m_now;
+
+    TxFrame& frame = m_frames[(m_head + m_count) % m_capacity];
+    frame.deadline = deadline;
+    frame.data = data;
+    m_count++;
+
+    m_nextTx = deadline + m_interval;
+    return true;
+}
+
+/// <summary>
+/// Updates the queue by the passed number of milliseconds, writing any frames that are due.
+/// </summary>
+/// <param name="ms"></param>
+void TxQueue::clock(uint32_t ms)
+{
+    m_now += ms;
+
+    while (m_count > 0U && m_frames[m_head].deadline <= m_now) {
+        m_network->writeDMR(m_frames[m_head].data);
+        m_head = (m_head + 1U) % m_capacity;
+        m_count--;
+    }
+}
+
+/// <summary>
+/// Discards any queued frames.
+/// </summary>
+void TxQueue::clear()
+{
+    m_head = 0U;
+    m_count = 0U;
+    m_nextTx = m_now;
+}
+
+/// <summary>
+/// Gets the number of milliseconds until the next queued frame is due.
+/// </summary>
+/// <param name="ms">Milliseconds until the next frame is due, zero if a frame is already due.</param>
+/// <returns>True, if a frame is queued, otherwise false if the queue is empty.</returns>
+bool TxQueue::getNextDeadline(uint32_t& ms) const
+{
+    ms = 0U;
+    if (m_count == 0U)
+        return false;
+
+    ulong64_t deadline = m_frames[m_head].deadline;
+    if (deadline > m_now)
+        ms = (uint32_t)(deadline - m_now);
+
+    return true;
+}
@@ -0,0 +1,88 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__DMR_TX_QUEUE_H__)
+#define __DMR_TX_QUEUE_H__
+
+#include "Defines.h"
+#include "dmr/data/Data.h"
+#include "network/BaseNetwork.h"
+
+namespace dmr
+{
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Implements a deadline-based transmit queue for a single DMR stream.
+    //      Frames are timestamped as they are queued and are written to the
+    //      network once their deadline has passed, which paces the outgoing
+    //      stream without blocking the caller. Frames are held in a ring of
+    //      fixed capacity that is allocated once, when the queue is created.
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API TxQueue {
+    public:
+        /// <summary>Initializes a new instance of the TxQueue class.</summary>
+        TxQueue(network::BaseNetwork* network, uint32_t interval, uint32_t capacity);
+        /// <summary>Finalizes a instance of the TxQueue class.</summary>
+        ~TxQueue();
+
+        /// <summary>Adds a DMR frame to the end of the transmit queue.</summary>
+        bool enqueue(const data::Data& data);
+
+        /// <summary>Updates the queue by the passed number of milliseconds, writing any frames that are due.</summary>
+        void clock(uint32_t ms);
+
+        /// <summary>Discards any queued frames.</summary>
+        void clear();
+
+        /// <summary>Gets the number of milliseconds until the next queued frame is due.</summary>
+        bool getNextDeadline(uint32_t& ms) const;
+
+        /// <summary>Helper to return whether the transmit queue is empty or not.</summary>
+        bool isEmpty() const { return m_count == 0U; }
+        /// <summary>Gets the number of frames waiting in the transmit queue.</summary>
+        uint32_t size() const { return m_count; }
+
+    private:
+        network::BaseNetwork* m_network;
+
+        uint32_t m_interval;
+
+        ulong64_t m_now;
+        ulong64_t m_nextTx;
+
+        struct TxFrame {
+            ulong64_t deadline;
+            data::Data data;
+        };
+
+        TxFrame* m_frames;
+        uint32_t m_capacity;
+        uint32_t m_head;
+        uint32_t m_count;
+    };
+} // namespace dmr
+
+#endif // __DMR_TX_QUEUE_H__
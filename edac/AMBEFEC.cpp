@@ -38,473 +38,426 @@
 using namespace edac;
 
 #include <cstdio>
+#include <cstring>
 #include <cassert>
 
 // ---------------------------------------------------------------------------
-//  Public Class Members
+//  Structure Declaration
+//      Byte tables for the 72-bit DMR AMBE frame. gather[n][v] is the (a, b, c)
+//      contribution of value v in byte n of the frame, and scatter[k][v] is the
+//      frame contribution of value v in byte chunk k of a, b or c (chunks run
+//      a >> 16, a >> 8, a, b >> 16, b >> 8, b, c >> 24, c >> 16, c >> 8, c). The
+//      first 8 frame bytes of a scatter entry are kept in memory order in hi.
 // ---------------------------------------------------------------------------
 
+struct AmbeFrameTables {
+    uint32_t gather[9][256][3];
+    uint64_t scatterHi[10][256];
+    uint8_t scatterLo[10][256];
+
+    AmbeFrameTables()
+    {
+        // frame position of each word bit, LSB first
+        uint32_t pos[3][25];
+        const uint32_t width[3] = { 24U, 23U, 25U };
+        for (uint32_t i = 0U; i < 24U; i++)
+            pos[0][23U - i] = AMBE_A_TABLE[i];
+        for (uint32_t i = 0U; i < 23U; i++)
+            pos[1][22U - i] = AMBE_B_TABLE[i];
+        for (uint32_t i = 0U; i < 25U; i++)
+            pos[2][24U - i] = AMBE_C_TABLE[i];
+
+        ::memset(gather, 0x00, sizeof(gather));
+        for (uint32_t w = 0U; w < 3U; w++) {
+            for (uint32_t bit = 0U; bit < width[w]; bit++) {
+                uint32_t n = pos[w][bit] >> 3;
+                uint32_t mask = BIT_MASK_TABLE[pos[w][bit] & 7U];
+                for (uint32_t v = 0U; v < 256U; v++) {
+                    if (v & mask)
+                        gather[n][v][w] |= 1U << bit;
+                }
+            }
+        }
+
+        const uint32_t chunkWord[10] = { 0U, 0U, 0U, 1U, 1U, 1U, 2U, 2U, 2U, 2U };
+        const uint32_t chunkShift[10] = { 16U, 8U, 0U, 16U, 8U, 0U, 24U, 16U, 8U, 0U };
+        for (uint32_t k = 0U; k < 10U; k++) {
+            uint32_t w = chunkWord[k];
+            for (uint32_t v = 0U; v < 256U; v++) {
+                uint8_t frame[9U];
+                ::memset(frame, 0x00U, 9U);
+                for (uint32_t t = 0U; t < 8U; t++) {
+                    uint32_t bit = chunkShift[k] + t;
+                    if (bit < width[w] && ((v >> t) & 1U))
+                        WRITE_BIT(frame, pos[w][bit], true);
+                }
+
+                ::memcpy(&scatterHi[k][v], frame, 8U);
+                scatterLo[k][v] = frame[8U];
+            }
+        }
+    }
+};
+
+static const AmbeFrameTables& ambeFrameTables()
+{
+    static const AmbeFrameTables tables;
+    return tables;
+}
+
 /// <summary>
-/// Initializes a new instance of the AMBEFEC class.
+/// Gathers the a, b and c words from a 72-bit DMR AMBE frame.
 /// </summary>
-AMBEFEC::AMBEFEC()
+static inline void gatherAMBE(const uint8_t* frame, uint32_t& a, uint32_t& b, uint32_t& c)
 {
-    /* stub */
+    const AmbeFrameTables& tables = ambeFrameTables();
+
+    a = b = c = 0U;
+    for (uint32_t n = 0U; n < 9U; n++) {
+        const uint32_t* g = tables.gather[n][frame[n]];
+        a |= g[0U];
+        b |= g[1U];
+        c |= g[2U];
+    }
 }
 
 /// <summary>
-/// Finalizes a instance of the AMBEFEC class.
+/// Scatters the a, b and c words back into a 72-bit DMR AMBE frame.
 /// </summary>
-AMBEFEC::~AMBEFEC()
+static inline void scatterAMBE(uint8_t* frame, uint32_t a, uint32_t b, uint32_t c)
 {
-    /* stub */
+    const AmbeFrameTables& tables = ambeFrameTables();
+    const uint32_t chunk[10] = {
+        (a >> 16) & 0xFFU, (a >> 8) & 0xFFU, a & 0xFFU,
+        (b >> 16) & 0xFFU, (b >> 8) & 0xFFU, b & 0xFFU,
+        (c >> 24) & 0xFFU, (c >> 16) & 0xFFU, (c >> 8) & 0xFFU, c & 0xFFU };
+
+    uint64_t hi = 0U;
+    uint8_t lo = 0U;
+    for (uint32_t k = 0U; k < 10U; k++) {
+        hi |= tables.scatterHi[k][chunk[k]];
+        lo |= tables.scatterLo[k][chunk[k]];
+    }
+
+    ::memcpy(frame, &hi, 8U);
+    frame[8U] = lo;
 }
 
 /// <summary>
-/// Regnerates the DMR AMBE FEC for the input bytes.
+/// Copies the second AMBE frame of a DMR voice burst out around the sync; its
+/// middle byte joins the high nibble of byte 13 to the low nibble of byte 19.
 /// </summary>
-/// <param name="bytes"></param>
-/// <returns>Count of errors.</returns>
-uint32_t AMBEFEC::regenerateDMR(uint8_t* bytes) const
+static inline void readDMRFrame2(const uint8_t* bytes, uint8_t* frame)
 {
-    assert(bytes != nullptr);
+    ::memcpy(frame, bytes + 9U, 4U);
+    frame[4U] = (bytes[13U] & 0xF0U) | (bytes[19U] & 0x0FU);
+    ::memcpy(frame + 5U, bytes + 20U, 4U);
+}
+
+/// <summary>
+/// Writes the second AMBE frame of a DMR voice burst back around the sync.
+/// </summary>
+static inline void writeDMRFrame2(uint8_t* bytes, const uint8_t* frame)
+{
+    ::memcpy(bytes + 9U, frame, 4U);
+    bytes[13U] = (bytes[13U] & 0x0FU) | (frame[4U] & 0xF0U);
+    bytes[19U] = (bytes[19U] & 0xF0U) | (frame[4U] & 0x0FU);
+    ::memcpy(bytes + 20U, frame + 5U, 4U);
+}
 
-    uint32_t a1 = 0U, a2 = 0U, a3 = 0U;
-    uint32_t b1 = 0U, b2 = 0U, b3 = 0U;
-    uint32_t c1 = 0U, c2 = 0U, c3 = 0U;
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+//      Nibble tables for the 144-bit IMBE interleave. The de-interleaved frame
+//      is held MSB first in three 64-bit words; deinterleave[n][v] is the
+//      contribution of value v in nibble n of the input bytes to it, and
+//      interleave[n][v] the output bytes (in memory order) for value v in
+//      nibble n of the de-interleaved frame.
+// ---------------------------------------------------------------------------
 
-    uint32_t MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t a1Pos = AMBE_A_TABLE[i];
-        uint32_t a2Pos = a1Pos + 72U;
-        if (a2Pos >= 108U)
-            a2Pos += 48U;
-        uint32_t a3Pos = a1Pos + 192U;
-
-        if (READ_BIT(bytes, a1Pos))
-            a1 |= MASK;
-        if (READ_BIT(bytes, a2Pos))
-            a2 |= MASK;
-        if (READ_BIT(bytes, a3Pos))
-            a3 |= MASK;
-    }
+struct ImbeInterleaveTables {
+    uint64_t deinterleave[36][16][3];
+    uint64_t interleave[36][16][3];
 
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t b1Pos = AMBE_B_TABLE[i];
-        uint32_t b2Pos = b1Pos + 72U;
-        if (b2Pos >= 108U)
-            b2Pos += 48U;
-        uint32_t b3Pos = b1Pos + 192U;
-
-        if (READ_BIT(bytes, b1Pos))
-            b1 |= MASK;
-        if (READ_BIT(bytes, b2Pos))
-            b2 |= MASK;
-        if (READ_BIT(bytes, b3Pos))
-            b3 |= MASK;            
-    }    
-
-	MASK = 0x1000000U;
-	for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-		uint32_t c1Pos = AMBE_C_TABLE[i];
-		uint32_t c2Pos = c1Pos + 72U;
-		if (c2Pos >= 108U)
-			c2Pos += 48U;
-		uint32_t c3Pos = c1Pos + 192U;
-
-		if (READ_BIT(bytes, c1Pos))
-			c1 |= MASK;
-		if (READ_BIT(bytes, c2Pos))
-			c2 |= MASK;
-		if (READ_BIT(bytes, c3Pos))
-			c3 |= MASK;
-	}
+    ImbeInterleaveTables()
+    {
+        ::memset(deinterleave, 0x00, sizeof(deinterleave));
+        ::memset(interleave, 0x00, sizeof(interleave));
 
-    uint32_t errors = regenerate(a1, b1, c1);
-    errors += regenerate(a2, b2, c2);
-    errors += regenerate(a3, b3, c3);
+        uint32_t inverse[144U];
+        for (uint32_t i = 0U; i < 144U; i++)
+            inverse[IMBE_INTERLEAVE[i]] = i;
 
-    MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t a1Pos = AMBE_A_TABLE[i];
-        uint32_t a2Pos = a1Pos + 72U;
-        if (a2Pos >= 108U)
-            a2Pos += 48U;
-        uint32_t a3Pos = a1Pos + 192U;
-
-        WRITE_BIT(bytes, a1Pos, a1 & MASK);
-        WRITE_BIT(bytes, a2Pos, a2 & MASK);
-        WRITE_BIT(bytes, a3Pos, a3 & MASK);
-    }
+        for (uint32_t n = 0U; n < 36U; n++) {
+            for (uint32_t v = 0U; v < 16U; v++) {
+                uint8_t bytes[24U];
+                ::memset(bytes, 0x00U, 24U);
 
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t b1Pos = AMBE_B_TABLE[i];
-        uint32_t b2Pos = b1Pos + 72U;
-        if (b2Pos >= 108U)
-            b2Pos += 48U;
-        uint32_t b3Pos = b1Pos + 192U;
-
-        WRITE_BIT(bytes, b1Pos, b1 & MASK);
-        WRITE_BIT(bytes, b2Pos, b2 & MASK);
-        WRITE_BIT(bytes, b3Pos, b3 & MASK);
-    }
+                for (uint32_t t = 0U; t < 4U; t++) {
+                    if (((v >> (3U - t)) & 1U) == 0U)
+                        continue;
 
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-        uint32_t c1Pos = AMBE_C_TABLE[i];
-        uint32_t c2Pos = c1Pos + 72U;
-        if (c2Pos >= 108U)
-            c2Pos += 48U;
-        uint32_t c3Pos = c1Pos + 192U;
-
-        WRITE_BIT(bytes, c1Pos, c1 & MASK);
-        WRITE_BIT(bytes, c2Pos, c2 & MASK);
-        WRITE_BIT(bytes, c3Pos, c3 & MASK);
+                    uint32_t i = inverse[(n * 4U) + t];
+                    deinterleave[n][v][i >> 6] |= 1ULL << (63U - (i & 63U));
+
+                    uint32_t pos = IMBE_INTERLEAVE[(n * 4U) + t];
+                    WRITE_BIT(bytes, pos, true);
+                }
+
+                ::memcpy(interleave[n][v], bytes, 24U);
+            }
+        }
     }
+};
 
-    return errors;
+static const ImbeInterleaveTables& imbeInterleaveTables()
+{
+    static const ImbeInterleaveTables tables;
+    return tables;
 }
 
 /// <summary>
-/// Returns the number of errors on the DMR BER input bytes.
+/// Reads len (up to 32) bits MSB first from offset of a de-interleaved IMBE frame.
 /// </summary>
-/// <param name="bytes"></param>
-/// <returns>Count of errors.</returns>
-uint32_t AMBEFEC::measureDMRBER(const uint8_t* bytes) const
+static inline uint32_t getIMBEBits(const uint64_t* frame, uint32_t offset, uint32_t len)
 {
-    assert(bytes != nullptr);
+    uint32_t w = offset >> 6;
+    uint32_t o = offset & 63U;
+    uint64_t v = frame[w] << o;
+    if (o + len > 64U)
+        v |= frame[w + 1U] >> (64U - o);
 
-    uint32_t a1 = 0U, a2 = 0U, a3 = 0U;
-    uint32_t b1 = 0U, b2 = 0U, b3 = 0U;
-    uint32_t c1 = 0U, c2 = 0U, c3 = 0U;
+    return (uint32_t)(v >> (64U - len));
+}
 
-    uint32_t MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t a1Pos = AMBE_A_TABLE[i];
-        uint32_t a2Pos = a1Pos + 72U;
-        if (a2Pos >= 108U)
-            a2Pos += 48U;
-        uint32_t a3Pos = a1Pos + 192U;
-
-        if (READ_BIT(bytes, a1Pos))
-            a1 |= MASK;
-        if (READ_BIT(bytes, a2Pos))
-            a2 |= MASK;
-        if (READ_BIT(bytes, a3Pos))
-            a3 |= MASK;
+/// <summary>
+/// Writes len (up to 32) bits MSB first at offset of a de-interleaved IMBE frame.
+/// </summary>
+static inline void setIMBEBits(uint64_t* frame, uint32_t offset, uint32_t len, uint32_t value)
+{
+    uint32_t w = offset >> 6;
+    uint32_t o = offset & 63U;
+    uint64_t mask = ((1ULL << len) - 1U) << (64U - len);
+    uint64_t v = (uint64_t)value << (64U - len);
+
+    frame[w] = (frame[w] & ~(mask >> o)) | (v >> o);
+    if (o + len > 64U) {
+        frame[w + 1U] = (frame[w + 1U] & ~(mask << (64U - o))) | (v << (64U - o));
     }
+}
 
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t b1Pos = AMBE_B_TABLE[i];
-        uint32_t b2Pos = b1Pos + 72U;
-        if (b2Pos >= 108U)
-            b2Pos += 48U;
-        uint32_t b3Pos = b1Pos + 192U;
-
-        if (READ_BIT(bytes, b1Pos))
-            b1 |= MASK;
-        if (READ_BIT(bytes, b2Pos))
-            b2 |= MASK;
-        if (READ_BIT(bytes, b3Pos))
-            b3 |= MASK;            
-    }    
-
-	MASK = 0x1000000U;
-	for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-		uint32_t c1Pos = AMBE_C_TABLE[i];
-		uint32_t c2Pos = c1Pos + 72U;
-		if (c2Pos >= 108U)
-			c2Pos += 48U;
-		uint32_t c3Pos = c1Pos + 192U;
-
-		if (READ_BIT(bytes, c1Pos))
-			c1 |= MASK;
-		if (READ_BIT(bytes, c2Pos))
-			c2 |= MASK;
-		if (READ_BIT(bytes, c3Pos))
-			c3 |= MASK;
-	}
+/// <summary>
+/// Corrects a packed Hamming (15,11,3) block, d[0] in bit 14; equivalent to
+/// Hamming::decode15113_1().
+/// </summary>
+static inline uint32_t decodeIMBEHamming(uint32_t d)
+{
+    // flipped bit (as a shift) for each syndrome, 15 where there is nothing to fix
+    static const uint8_t FLIP[16] = { 15U, 3U, 2U, 11U, 1U, 9U, 6U, 13U, 0U, 8U, 5U, 12U, 4U, 10U, 7U, 14U };
 
-    uint32_t errors = regenerate(a1, b1, c1);
-    errors += regenerate(a2, b2, c2);
-    errors += regenerate(a3, b3, c3);
+    uint32_t n = 0U;
+    n |= (Utils::countBits32(d & 0x7F08U) & 1U);
+    n |= (Utils::countBits32(d & 0x78E4U) & 1U) << 1;
+    n |= (Utils::countBits32(d & 0x66D2U) & 1U) << 2;
+    n |= (Utils::countBits32(d & 0x55B1U) & 1U) << 3;
 
-    return errors;
+    return d ^ ((1U << FLIP[n]) & 0x7FFFU);
 }
 
 /// <summary>
-/// Regenerates the P25 IMBE FEC for the input bytes.
+/// De-interleaves the 18 input bytes into a packed IMBE frame.
 /// </summary>
-/// <param name="bytes"></param>
-/// <returns>Count of errors.</returns>
-uint32_t AMBEFEC::regenerateIMBE(uint8_t* bytes) const
+static inline void deinterleaveIMBE(const uint8_t* bytes, uint64_t* frame)
 {
-    assert(bytes != nullptr);
-
-    bool orig[144U];
-    bool temp[144U];
-
-    // De-interleave
-    for (uint32_t i = 0U; i < 144U; i++) {
-        uint32_t n = IMBE_INTERLEAVE[i];
-        orig[i] = temp[i] = READ_BIT(bytes, n);
+    const ImbeInterleaveTables& tables = imbeInterleaveTables();
+
+    frame[0U] = frame[1U] = frame[2U] = 0U;
+    for (uint32_t n = 0U; n < 18U; n++) {
+        const uint64_t* hi = tables.deinterleave[n * 2U][bytes[n] >> 4];
+        const uint64_t* lo = tables.deinterleave[(n * 2U) + 1U][bytes[n] & 0x0FU];
+        frame[0U] |= hi[0U] | lo[0U];
+        frame[1U] |= hi[1U] | lo[1U];
+        frame[2U] |= hi[2U] | lo[2U];
     }
+}
 
-    // now ..
-
-    // 12 voice bits     0
-    // 11 golay bits     12
-    //
-    // 12 voice bits     23
-    // 11 golay bits     35
-    //
-    // 12 voice bits     46
-    // 11 golay bits     58
-    //
-    // 12 voice bits     69
-    // 11 golay bits     81
-    //
-    // 11 voice bits     92
-    //  4 hamming bits   103
-    //
-    // 11 voice bits     107
-    //  4 hamming bits   118
-    //
-    // 11 voice bits     122
-    //  4 hamming bits   133
-    //
-    //  7 voice bits     137
-
-    // Process the c0 section first to allow the de-whitening to be accurate
-
-    // Check/Fix FEC
-    bool* bit = temp;
-
-    // c0
-    uint32_t g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c0data = Golay24128::decode23127(g1);
-    uint32_t g2 = Golay24128::encode23127(c0data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
+/// <summary>
+/// Interleaves a packed IMBE frame into the 18 output bytes.
+/// </summary>
+static inline void interleaveIMBE(const uint64_t* frame, uint8_t* bytes)
+{
+    const ImbeInterleaveTables& tables = imbeInterleaveTables();
+
+    uint64_t out[3U] = { 0U, 0U, 0U };
+    for (uint32_t n = 0U; n < 36U; n++) {
+        uint32_t v = (uint32_t)(frame[n >> 4] >> (60U - ((n & 15U) * 4U))) & 0x0FU;
+        const uint64_t* w = tables.interleave[n][v];
+        out[0U] |= w[0U];
+        out[1U] |= w[1U];
+        out[2U] |= w[2U];
     }
-    bit += 23U;
 
-    bool prn[114U];
+    ::memcpy(bytes, out, 18U);
+}
+
+/// <summary>
+/// Regenerates the FEC of a packed IMBE frame in place.
+/// </summary>
+/// <remarks>
+///  12 voice bits     0     11 golay bits     12
+///  12 voice bits     23    11 golay bits     35
+///  12 voice bits     46    11 golay bits     58
+///  12 voice bits     69    11 golay bits     81
+///  11 voice bits     92     4 hamming bits   103
+///  11 voice bits     107    4 hamming bits   118
+///  11 voice bits     122    4 hamming bits   133
+///   7 voice bits     137
+/// </remarks>
+/// <returns>Count of errors.</returns>
+static uint32_t regenerateIMBEFrame(uint64_t* frame)
+{
+    uint64_t orig[3U] = { frame[0U], frame[1U], frame[2U] };
+
+    // Process the c0 section first to allow the de-whitening to be accurate; each
+    // Golay block is written back as the 24-bit encode23127() value, as it always
+    // has been, which leaves a zero in the first bit of the block after it
+    uint32_t c0data = Golay24128::decode23127(getIMBEBits(frame, 0U, 23U));
+    setIMBEBits(frame, 0U, 24U, Golay24128::encode23127(c0data));
 
-    // Create the whitening vector and save it for future use
+    // Create the whitening vector for bits 23 - 136
+    uint64_t prn[3U] = { 0U, 0U, 0U };
     uint32_t p = 16U * c0data;
-    for (uint32_t i = 0U; i < 114U; i++) {
+    for (uint32_t i = 23U; i < 137U; i++) {
         p = (173U * p + 13849U) % 65536U;
-        prn[i] = p >= 32768U;
+        if (p >= 32768U)
+            prn[i >> 6] |= 1ULL << (63U - (i & 63U));
     }
 
     // De-whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
-
-    // c1
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c1data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c1data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    // c2
-    g1 = 0;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c2data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c2data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
+    for (uint32_t i = 0U; i < 3U; i++)
+        frame[i] ^= prn[i];
+
+    // c1 - c3
+    for (uint32_t offset = 23U; offset < 92U; offset += 23U) {
+        uint32_t data = Golay24128::decode23127(getIMBEBits(frame, offset, 23U));
+        setIMBEBits(frame, offset, 24U, Golay24128::encode23127(data));
     }
-    bit += 23U;
-
-    // c3
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c3data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c3data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
+
+    // c4 - c6
+    for (uint32_t offset = 92U; offset < 137U; offset += 15U)
+        setIMBEBits(frame, offset, 15U, decodeIMBEHamming(getIMBEBits(frame, offset, 15U)));
+
+    // Whiten some bits
+    uint32_t errors = 0U;
+    for (uint32_t i = 0U; i < 3U; i++) {
+        frame[i] ^= prn[i];
+        errors += Utils::countBits64(orig[i] ^ frame[i]);
     }
-    bit += 23U;
 
-    // c4
-    Hamming::decode15113_1(bit);
-    bit += 15U;
+    return errors;
+}
 
-    // c5
-    Hamming::decode15113_1(bit);
-    bit += 15U;
 
-    // c6
-    Hamming::decode15113_1(bit);
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
 
-    // Whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
+/// <summary>
+/// Initializes a new instance of the AMBEFEC class.
+/// </summary>
+AMBEFEC::AMBEFEC()
+{
+    /* stub */
+}
 
-    uint32_t errors = 0U;
-    for (uint32_t i = 0U; i < 144U; i++) {
-        if (orig[i] != temp[i])
-            errors++;
-    }
+/// <summary>
+/// Finalizes a instance of the AMBEFEC class.
+/// </summary>
+AMBEFEC::~AMBEFEC()
+{
+    /* stub */
+}
 
-    // Interleave
-    for (uint32_t i = 0U; i < 144U; i++) {
-        uint32_t n = IMBE_INTERLEAVE[i];
-        WRITE_BIT(bytes, n, temp[i]);
-    }
+/// <summary>
+/// Regnerates the DMR AMBE FEC for the input bytes.
+/// </summary>
+/// <param name="bytes"></param>
+/// <returns>Count of errors.</returns>
+uint32_t AMBEFEC::regenerateDMR(uint8_t* bytes) const
+{
+    assert(bytes != nullptr);
+
+    uint8_t frame2[9U];
+    readDMRFrame2(bytes, frame2);
+
+    uint32_t a[3U], b[3U], c[3U];
+    gatherAMBE(bytes, a[0U], b[0U], c[0U]);
+    gatherAMBE(frame2, a[1U], b[1U], c[1U]);
+    gatherAMBE(bytes + 24U, a[2U], b[2U], c[2U]);
+
+    uint32_t errors = regenerate(a, b, c, 3U);
+
+    scatterAMBE(bytes, a[0U], b[0U], c[0U]);
+    scatterAMBE(frame2, a[1U], b[1U], c[1U]);
+    scatterAMBE(bytes + 24U, a[2U], b[2U], c[2U]);
+    writeDMRFrame2(bytes, frame2);
 
     return errors;
 }
 
 /// <summary>
-/// Returns the number of errors on the P25 BER input bytes.
+/// Returns the number of errors on the DMR BER input bytes.
 /// </summary>
 /// <param name="bytes"></param>
 /// <returns>Count of errors.</returns>
-uint32_t AMBEFEC::measureP25BER(const uint8_t* bytes) const
+uint32_t AMBEFEC::measureDMRBER(const uint8_t* bytes) const
 {
     assert(bytes != nullptr);
 
-    bool orig[144U];
-    bool temp[144U];
+    uint8_t frame2[9U];
+    readDMRFrame2(bytes, frame2);
 
-    // De-interleave
-    for (uint32_t i = 0U; i < 144U; i++) {
-        uint32_t n = IMBE_INTERLEAVE[i];
-        orig[i] = temp[i] = READ_BIT(bytes, n);
-    }
+    uint32_t a[3U], b[3U], c[3U];
+    gatherAMBE(bytes, a[0U], b[0U], c[0U]);
+    gatherAMBE(frame2, a[1U], b[1U], c[1U]);
+    gatherAMBE(bytes + 24U, a[2U], b[2U], c[2U]);
 
-    // now ..
-
-    // 12 voice bits     0
-    // 11 golay bits     12
-    //
-    // 12 voice bits     23
-    // 11 golay bits     35
-    //
-    // 12 voice bits     46
-    // 11 golay bits     58
-    //
-    // 12 voice bits     69
-    // 11 golay bits     81
-    //
-    // 11 voice bits     92
-    //  4 hamming bits   103
-    //
-    // 11 voice bits     107
-    //  4 hamming bits   118
-    //
-    // 11 voice bits     122
-    //  4 hamming bits   133
-    //
-    //  7 voice bits     137
-
-    // Process the c0 section first to allow the de-whitening to be accurate
-
-    // Check/Fix FEC
-    bool* bit = temp;
-
-    // c0
-    uint32_t g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c0data = Golay24128::decode23127(g1);
-    uint32_t g2 = Golay24128::encode23127(c0data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
+    uint32_t errors = regenerate(a, b, c, 3U);
 
-    bool prn[114U];
+    return errors;
+}
 
-    // Create the whitening vector and save it for future use
-    uint32_t p = 16U * c0data;
-    for (uint32_t i = 0U; i < 114U; i++) {
-        p = (173U * p + 13849U) % 65536U;
-        prn[i] = p >= 32768U;
-    }
+/// <summary>
+/// Regenerates the P25 IMBE FEC for the input bytes.
+/// </summary>
+/// <param name="bytes"></param>
+/// <returns>Count of errors.</returns>
+uint32_t AMBEFEC::regenerateIMBE(uint8_t* bytes) const
+{
+    assert(bytes != nullptr);
 
-    // De-whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
-
-    // c1
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c1data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c1data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    // c2
-    g1 = 0;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c2data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c2data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    // c3
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c3data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c3data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
+    uint64_t frame[3U];
+    deinterleaveIMBE(bytes, frame);
 
-    // c4
-    Hamming::decode15113_1(bit);
-    bit += 15U;
+    uint32_t errors = regenerateIMBEFrame(frame);
 
-    // c5
-    Hamming::decode15113_1(bit);
-    bit += 15U;
+    interleaveIMBE(frame, bytes);
 
-    // c6
-    Hamming::decode15113_1(bit);
+    return errors;
+}
 
-    // Whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
+/// <summary>
+/// Returns the number of errors on the P25 BER input bytes.
+/// </summary>
+/// <param name="bytes"></param>
+/// <returns>Count of errors.</returns>
+uint32_t AMBEFEC::measureP25BER(const uint8_t* bytes) const
+{
+    assert(bytes != nullptr);
 
-    uint32_t errors = 0U;
-    for (uint32_t i = 0U; i < 144U; i++) {
-        if (orig[i] != temp[i])
-            errors++;
-    }
+    uint64_t frame[3U];
+    deinterleaveIMBE(bytes, frame);
 
-    return errors;
+    return regenerateIMBEFrame(frame);
 }
 
 /// <summary>
@@ -615,40 +568,69 @@ uint32_t AMBEFEC::measureNXDNBER(uint8_t* bytes) const
 /// <returns></returns>
 uint32_t AMBEFEC::regenerate(uint32_t& a, uint32_t& b, uint32_t& c, bool ignoreParity) const
 {
-	uint32_t old_a = a;
-	uint32_t old_b = b;
-
-	uint32_t data;
-	bool valid = Golay24128::decode24128(a, data);
-	if (!valid && !ignoreParity) {
-		a = 0xF00292U;
-		b = 0x0E0B20U;
-		c = 0x000000U;
-		return 10U;		// An invalid A block gives an error count of 10
-	}
+    return regenerate(&a, &b, &c, 1U, ignoreParity);
+}
+
+/// <summary>
+/// Regenerates up to three AMBE codewords, decoding their Golay blocks as one batch.
+/// </summary>
+/// <param name="a"></param>
+/// <param name="b"></param>
+/// <param name="c"></param>
+/// <param name="count"></param>
+/// <param name="ignoreParity"></param>
+/// <returns></returns>
+uint32_t AMBEFEC::regenerate(uint32_t* a, uint32_t* b, uint32_t* c, uint32_t count, bool ignoreParity) const
+{
+	assert(count <= 3U);
 
-	a = Golay24128::encode24128(data);
+	uint32_t data[3U];
+	bool valid[3U];
+	Golay24128::decode24128(data, a, count, valid);
+
+	uint32_t newA[3U];
+	Golay24128::encode24128(newA, data, count);
 
 	// PRNG
-	uint32_t p = PRNG_TABLE[data] >> 1;
-	b ^= p;
+	uint32_t p[3U];
+	uint32_t whitened[3U];
+	for (uint32_t i = 0U; i < count; i++) {
+		p[i] = PRNG_TABLE[data[i]] >> 1;
+		whitened[i] = b[i] ^ p[i];
+	}
+
+	uint32_t datb[3U];
+	Golay24128::decode23127(datb, whitened, count);
+
+	uint32_t newB[3U];
+	Golay24128::encode23127(newB, datb, count);
+
+	uint32_t errors = 0U;
+	for (uint32_t i = 0U; i < count; i++) {
+		if (!valid[i] && !ignoreParity) {
+			a[i] = 0xF00292U;
+			b[i] = 0x0E0B20U;
+			c[i] = 0x000000U;
+			errors += 10U;		// An invalid A block gives an error count of 10
+			continue;
+		}
 
-	uint32_t datb = Golay24128::decode23127(b);
-	b = Golay24128::encode23127(datb) >> 1;
+		uint32_t errsA = Utils::countBits32(newA[i] ^ a[i]);
 
-	b ^= p;
+		newB[i] = (newB[i] >> 1) ^ p[i];
+		uint32_t errsB = Utils::countBits32(newB[i] ^ b[i]);
 
-	uint32_t v = a ^ old_a;
-	uint32_t errsA = Utils::countBits32(v);
+		a[i] = newA[i];
+		b[i] = newB[i];
 
-	v = b ^ old_b;
-	uint32_t errsB = Utils::countBits32(v);
+		if (errsA >= 4U || ((errsA + errsB) >= 6U && errsA >= 2U)) {
+			a[i] = 0xF00292U;
+			b[i] = 0x0E0B20U;
+			c[i] = 0x000000U;
+		}
 
-	if (errsA >= 4U || ((errsA + errsB) >= 6U && errsA >= 2U)) {
-		a = 0xF00292U;
-		b = 0x0E0B20U;
-		c = 0x000000U;
+		errors += errsA + errsB;
 	}
 
-	return errsA + errsB;
+	return errors;
 }
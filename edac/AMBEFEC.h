@@ -500,6 +500,8 @@ namespace edac
     private:
         /// <summary></summary>
         uint32_t regenerate(uint32_t& a, uint32_t& b, uint32_t& c, bool ignoreParity = true) const;
+        /// <summary></summary>
+        uint32_t regenerate(uint32_t* a, uint32_t* b, uint32_t* c, uint32_t count, bool ignoreParity = true) const;
     };
 } // namespace edac
 
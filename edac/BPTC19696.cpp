@@ -30,7 +30,6 @@
 */
 #include "Defines.h"
 #include "edac/BPTC19696.h"
-#include "edac/Hamming.h"
 #include "Utils.h"
 
 using namespace edac;
@@ -39,6 +38,125 @@ using namespace edac;
 #include <cassert>
 #include <cstring>
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+// parity checks of Hamming (15,11,3) over a row word and Hamming (13,9,3) over
+// the 13 rows of a column; bit 14 of a row word is column 0, bit 0 of a column
+// mask is row 0
+const uint16_t HAMMING_15113_CHECK[4U] = { 0x7AC8U, 0x3D64U, 0x1EB2U, 0x7591U };
+const uint16_t HAMMING_1393_CHECK[4U] = { 0x026BU, 0x04D7U, 0x09AFU, 0x1135U };
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+//      Tables for the packed BPTC (196,96) matrix. The 196 bits are held MSB
+//      first in four 64-bit words; deinterleave[n][v] is the contribution of
+//      value v in nibble n of the raw bits to the de-interleaved bits, and
+//      interleave[n][v] the reverse. syndrome[h][v] is the Hamming (15,11,3)
+//      syndrome of byte v in the high (h = 0) or low byte of a row word, with
+//      check k in bit 3 - k, so that it lines up with the parity bits of the
+//      row; rowFix[s] and colFix[s] give the bit to flip for a syndrome s.
+// ---------------------------------------------------------------------------
+
+struct BPTC19696Tables {
+    uint64_t deinterleave[49U][16U][4U];
+    uint64_t interleave[49U][16U][4U];
+    uint8_t syndrome[2U][256U];
+    uint16_t rowFix[16U];
+    uint16_t colFix[16U];
+
+    BPTC19696Tables()
+    {
+        ::memset(deinterleave, 0x00, sizeof(deinterleave));
+        ::memset(interleave, 0x00, sizeof(interleave));
+        for (uint32_t a = 0U; a < 196U; a++) {
+            uint32_t i = (a * 181U) % 196U;
+            for (uint32_t v = 0U; v < 16U; v++) {
+                if (v & (0x08U >> (i & 3U)))
+                    deinterleave[i >> 2][v][a >> 6] |= 1ULL << (63U - (a & 63U));
+                if (v & (0x08U >> (a & 3U)))
+                    interleave[a >> 2][v][i >> 6] |= 1ULL << (63U - (i & 63U));
+            }
+        }
+
+        for (uint32_t v = 0U; v < 256U; v++) {
+            syndrome[0U][v] = rowSyndrome(v << 8);
+            syndrome[1U][v] = rowSyndrome(v);
+        }
+
+        // a single bit in error gives a syndrome of the checks it takes part in
+        ::memset(rowFix, 0x00, sizeof(rowFix));
+        for (uint32_t bit = 0U; bit < 15U; bit++)
+            rowFix[rowSyndrome(1U << bit)] = 1U << bit;
+
+        ::memset(colFix, 0x00, sizeof(colFix));
+        for (uint32_t row = 0U; row < 13U; row++) {
+            uint32_t s = 0U;
+            for (uint32_t k = 0U; k < 4U; k++)
+                s |= ((HAMMING_1393_CHECK[k] >> row) & 1U) << (3U - k);
+            colFix[s] = 1U << row;
+        }
+    }
+
+    static uint8_t rowSyndrome(uint32_t row)
+    {
+        uint8_t s = 0U;
+        for (uint32_t k = 0U; k < 4U; k++)
+            s |= (Utils::countBits32(row & HAMMING_15113_CHECK[k]) & 1U) << (3U - k);
+        return s;
+    }
+};
+
+static const BPTC19696Tables& bptcTables()
+{
+    static const BPTC19696Tables tables;
+    return tables;
+}
+
+/// <summary>
+/// Reads len (up to 16) bits MSB first from offset of a packed 196-bit matrix.
+/// </summary>
+static inline uint32_t getBits(const uint64_t* bits, uint32_t offset, uint32_t len)
+{
+    uint32_t w = offset >> 6;
+    uint32_t o = offset & 63U;
+    uint64_t v = bits[w] << o;
+    if (o + len > 64U)
+        v |= bits[w + 1U] >> (64U - o);
+
+    return (uint32_t)(v >> (64U - len));
+}
+
+/// <summary>
+/// Ors len (up to 16) bits MSB first into offset of a packed 196-bit matrix.
+/// </summary>
+static inline void orBits(uint64_t* bits, uint32_t offset, uint32_t len, uint32_t value)
+{
+    uint32_t w = offset >> 6;
+    uint32_t o = offset & 63U;
+    uint64_t v = (uint64_t)value << (64U - len);
+
+    bits[w] |= v >> o;
+    if (o + len > 64U)
+        bits[w + 1U] |= v << (64U - o);
+}
+
+/// <summary>
+/// Permutes a packed 196-bit matrix through the given nibble table.
+/// </summary>
+static inline void permute(const uint64_t table[49U][16U][4U], const uint64_t* in, uint64_t* out)
+{
+    out[0U] = out[1U] = out[2U] = out[3U] = 0U;
+    for (uint32_t n = 0U; n < 49U; n++) {
+        const uint64_t* p = table[n][(in[n >> 4] >> (60U - ((n & 15U) * 4U))) & 0x0FU];
+        out[0U] |= p[0U];
+        out[1U] |= p[1U];
+        out[2U] |= p[2U];
+        out[3U] |= p[3U];
+    }
+}
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -46,12 +164,10 @@ using namespace edac;
 /// <summary>
 /// Initializes a new instance of the BPTC19696 class.
 /// </summary>
-BPTC19696::BPTC19696() :
-    m_rawData(nullptr),
-    m_deInterData(nullptr)
+BPTC19696::BPTC19696()
 {
-    m_rawData = new bool[196];
-    m_deInterData = new bool[196];
+    ::memset(m_rawData, 0x00U, sizeof(m_rawData));
+    ::memset(m_deInterData, 0x00U, sizeof(m_deInterData));
 }
 
 /// <summary>
@@ -59,8 +175,7 @@ BPTC19696::BPTC19696() :
 /// </summary>
 BPTC19696::~BPTC19696()
 {
-    delete[] m_rawData;
-    delete[] m_deInterData;
+    /* stub */
 }
 
 /// <summary>
@@ -119,40 +234,19 @@ void BPTC19696::encode(const uint8_t* in, uint8_t* out)
 /// <param name="in"></param>
 void BPTC19696::decodeExtractBinary(const uint8_t* in)
 {
+    ::memset(m_rawData, 0x00U, sizeof(m_rawData));
+
     // First block
-    Utils::byteToBitsBE(in[0U], m_rawData + 0U);
-    Utils::byteToBitsBE(in[1U], m_rawData + 8U);
-    Utils::byteToBitsBE(in[2U], m_rawData + 16U);
-    Utils::byteToBitsBE(in[3U], m_rawData + 24U);
-    Utils::byteToBitsBE(in[4U], m_rawData + 32U);
-    Utils::byteToBitsBE(in[5U], m_rawData + 40U);
-    Utils::byteToBitsBE(in[6U], m_rawData + 48U);
-    Utils::byteToBitsBE(in[7U], m_rawData + 56U);
-    Utils::byteToBitsBE(in[8U], m_rawData + 64U);
-    Utils::byteToBitsBE(in[9U], m_rawData + 72U);
-    Utils::byteToBitsBE(in[10U], m_rawData + 80U);
-    Utils::byteToBitsBE(in[11U], m_rawData + 88U);
-    Utils::byteToBitsBE(in[12U], m_rawData + 96U);
+    for (uint32_t i = 0U; i < 12U; i++)
+        orBits(m_rawData, i * 8U, 8U, in[i]);
 
     // Handle the two bits
-    bool bits[8U];
-    Utils::byteToBitsBE(in[20U], bits);
-    m_rawData[98U] = bits[6U];
-    m_rawData[99U] = bits[7U];
+    orBits(m_rawData, 96U, 2U, in[12U] >> 6);
+    orBits(m_rawData, 98U, 2U, in[20U] & 0x03U);
 
     // Second block
-    Utils::byteToBitsBE(in[21U], m_rawData + 100U);
-    Utils::byteToBitsBE(in[22U], m_rawData + 108U);
-    Utils::byteToBitsBE(in[23U], m_rawData + 116U);
-    Utils::byteToBitsBE(in[24U], m_rawData + 124U);
-    Utils::byteToBitsBE(in[25U], m_rawData + 132U);
-    Utils::byteToBitsBE(in[26U], m_rawData + 140U);
-    Utils::byteToBitsBE(in[27U], m_rawData + 148U);
-    Utils::byteToBitsBE(in[28U], m_rawData + 156U);
-    Utils::byteToBitsBE(in[29U], m_rawData + 164U);
-    Utils::byteToBitsBE(in[30U], m_rawData + 172U);
-    Utils::byteToBitsBE(in[31U], m_rawData + 180U);
-    Utils::byteToBitsBE(in[32U], m_rawData + 188U);
+    for (uint32_t i = 0U; i < 12U; i++)
+        orBits(m_rawData, 100U + (i * 8U), 8U, in[21U + i]);
 }
 
 /// <summary>
@@ -160,16 +254,12 @@ void BPTC19696::decodeExtractBinary(const uint8_t* in)
 /// </summary>
 void BPTC19696::decodeDeInterleave()
 {
-    for (uint32_t i = 0U; i < 196U; i++)
-        m_deInterData[i] = false;
+    uint64_t deInterData[4U];
+    permute(bptcTables().deinterleave, m_rawData, deInterData);
 
     // The first bit is R(3) which is not used so can be ignored
-    for (uint32_t a = 0U; a < 196U; a++) {
-        // Calculate the interleave sequence
-        uint32_t interleaveSequence = (a * 181U) % 196U;
-        // Shuffle the data
-        m_deInterData[a] = m_rawData[interleaveSequence];
-    }
+    for (uint32_t r = 0U; r < 13U; r++)
+        m_deInterData[r] = (uint16_t)getBits(deInterData, (r * 15U) + 1U, 15U);
 }
 
 /// <summary>
@@ -177,36 +267,49 @@ void BPTC19696::decodeDeInterleave()
 /// </summary>
 void BPTC19696::decodeErrorCheck()
 {
+    const BPTC19696Tables& tables = bptcTables();
+
     bool fixing;
     uint32_t count = 0U;
     do {
         fixing = false;
 
-        // Run through each of the 15 columns
-        bool col[13U];
-        for (uint32_t c = 0U; c < 15U; c++) {
-            uint32_t pos = c + 1U;
-            for (uint32_t a = 0U; a < 13U; a++) {
-                col[a] = m_deInterData[pos];
-                pos = pos + 15U;
+        // Run through each of the 15 columns; the checks of all columns are
+        // taken at once, bit 14 - c of check k belonging to column c
+        uint16_t check[4U] = { 0U, 0U, 0U, 0U };
+        for (uint32_t r = 0U; r < 13U; r++) {
+            for (uint32_t k = 0U; k < 4U; k++) {
+                if ((HAMMING_1393_CHECK[k] >> r) & 1U)
+                    check[k] ^= m_deInterData[r];
             }
+        }
 
-            if (Hamming::decode1393(col)) {
-                uint32_t pos = c + 1U;
-                for (uint32_t a = 0U; a < 13U; a++) {
-                    m_deInterData[pos] = col[a];
-                    pos = pos + 15U;
-                }
+        if ((check[0U] | check[1U] | check[2U] | check[3U]) != 0U) {
+            for (uint32_t c = 0U; c < 15U; c++) {
+                uint32_t bit = 14U - c;
+                uint32_t s = (((check[0U] >> bit) & 1U) << 3) | (((check[1U] >> bit) & 1U) << 2) |
+                    (((check[2U] >> bit) & 1U) << 1) | ((check[3U] >> bit) & 1U);
 
-                fixing = true;
+                uint16_t fix = tables.colFix[s];
+                if (fix != 0U) {
+                    for (uint32_t r = 0U; r < 13U; r++) {
+                        if ((fix >> r) & 1U)
+                            m_deInterData[r] ^= 1U << bit;
+                    }
+
+                    fixing = true;
+                }
             }
         }
 
         // Run through each of the 9 rows containing data
         for (uint32_t r = 0U; r < 9U; r++) {
-            uint32_t pos = (r * 15U) + 1U;
-            if (Hamming::decode15113_2(m_deInterData + pos))
+            uint16_t row = m_deInterData[r];
+            uint32_t s = tables.syndrome[0U][row >> 8] ^ tables.syndrome[1U][row & 0xFFU];
+            if (s != 0U) {
+                m_deInterData[r] = row ^ tables.rowFix[s];
                 fixing = true;
+            }
         }
 
         count++;
@@ -219,99 +322,32 @@ void BPTC19696::decodeErrorCheck()
 /// <param name="data"></param>
 void BPTC19696::decodeExtractData(uint8_t* data) const
 {
-    bool bData[96U];
-    uint32_t pos = 0U;
-    for (uint32_t a = 4U; a <= 11U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 16U; a <= 26U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 31U; a <= 41U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 46U; a <= 56U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 61U; a <= 71U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 76U; a <= 86U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 91U; a <= 101U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 106U; a <= 116U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 121U; a <= 131U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    Utils::bitsToByteBE(bData + 0U, data[0U]);
-    Utils::bitsToByteBE(bData + 8U, data[1U]);
-    Utils::bitsToByteBE(bData + 16U, data[2U]);
-    Utils::bitsToByteBE(bData + 24U, data[3U]);
-    Utils::bitsToByteBE(bData + 32U, data[4U]);
-    Utils::bitsToByteBE(bData + 40U, data[5U]);
-    Utils::bitsToByteBE(bData + 48U, data[6U]);
-    Utils::bitsToByteBE(bData + 56U, data[7U]);
-    Utils::bitsToByteBE(bData + 64U, data[8U]);
-    Utils::bitsToByteBE(bData + 72U, data[9U]);
-    Utils::bitsToByteBE(bData + 80U, data[10U]);
-    Utils::bitsToByteBE(bData + 88U, data[11U]);
+    // 8 data bits in columns 3 - 10 of the first row, then 11 in columns 0 - 10
+    // of the next eight
+    uint64_t bData[2U] = { 0U, 0U };
+    orBits(bData, 0U, 8U, (m_deInterData[0U] >> 4) & 0xFFU);
+    for (uint32_t r = 1U; r < 9U; r++)
+        orBits(bData, 8U + ((r - 1U) * 11U), 11U, m_deInterData[r] >> 4);
+
+    for (uint32_t i = 0U; i < 12U; i++)
+        data[i] = (uint8_t)(bData[i >> 3] >> (56U - ((i & 7U) * 8U)));
 }
 
 /// <summary>
 ///
 /// </summary>
 /// <param name="in"></param>
-void BPTC19696::encodeExtractData(const uint8_t* in) const
+void BPTC19696::encodeExtractData(const uint8_t* in)
 {
-    bool bData[96U];
-    Utils::byteToBitsBE(in[0U], bData + 0U);
-    Utils::byteToBitsBE(in[1U], bData + 8U);
-    Utils::byteToBitsBE(in[2U], bData + 16U);
-    Utils::byteToBitsBE(in[3U], bData + 24U);
-    Utils::byteToBitsBE(in[4U], bData + 32U);
-    Utils::byteToBitsBE(in[5U], bData + 40U);
-    Utils::byteToBitsBE(in[6U], bData + 48U);
-    Utils::byteToBitsBE(in[7U], bData + 56U);
-    Utils::byteToBitsBE(in[8U], bData + 64U);
-    Utils::byteToBitsBE(in[9U], bData + 72U);
-    Utils::byteToBitsBE(in[10U], bData + 80U);
-    Utils::byteToBitsBE(in[11U], bData + 88U);
-
-    for (uint32_t i = 0U; i < 196U; i++)
-        m_deInterData[i] = false;
-
-    uint32_t pos = 0U;
-    for (uint32_t a = 4U; a <= 11U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 16U; a <= 26U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 31U; a <= 41U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 46U; a <= 56U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 61U; a <= 71U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 76U; a <= 86U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 91U; a <= 101U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 106U; a <= 116U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 121U; a <= 131U; a++, pos++)
-        m_deInterData[a] = bData[pos];
+    uint64_t bData[2U] = { 0U, 0U };
+    for (uint32_t i = 0U; i < 12U; i++)
+        orBits(bData, i * 8U, 8U, in[i]);
+
+    ::memset(m_deInterData, 0x00U, sizeof(m_deInterData));
+
+    m_deInterData[0U] = (uint16_t)(getBits(bData, 0U, 8U) << 4);
+    for (uint32_t r = 1U; r < 9U; r++)
+        m_deInterData[r] = (uint16_t)(getBits(bData, 8U + ((r - 1U) * 11U), 11U) << 4);
 }
 
 /// <summary>
@@ -319,28 +355,24 @@ void BPTC19696::encodeExtractData(const uint8_t* in) const
 /// </summary>
 void BPTC19696::encodeErrorCheck()
 {
+    const BPTC19696Tables& tables = bptcTables();
+
     // Run through each of the 9 rows containing data
     for (uint32_t r = 0U; r < 9U; r++) {
-        uint32_t pos = (r * 15U) + 1U;
-        Hamming::encode15113_2(m_deInterData + pos);
+        uint16_t row = m_deInterData[r];
+        m_deInterData[r] = row | (tables.syndrome[0U][row >> 8] ^ tables.syndrome[1U][row & 0xFFU]);
     }
 
-    // Run through each of the 15 columns
-    bool col[13U];
-    for (uint32_t c = 0U; c < 15U; c++) {
-        uint32_t pos = c + 1U;
-        for (uint32_t a = 0U; a < 13U; a++) {
-            col[a] = m_deInterData[pos];
-            pos = pos + 15U;
+    // Run through each of the 15 columns; the parity rows are the column checks
+    // over the 9 rows above them
+    for (uint32_t k = 0U; k < 4U; k++) {
+        uint16_t parity = 0U;
+        for (uint32_t r = 0U; r < 9U; r++) {
+            if ((HAMMING_1393_CHECK[k] >> r) & 1U)
+                parity ^= m_deInterData[r];
         }
 
-        Hamming::encode1393(col);
-
-        pos = c + 1U;
-        for (uint32_t a = 0U; a < 13U; a++) {
-            m_deInterData[pos] = col[a];
-            pos = pos + 15U;
-        }
+        m_deInterData[9U + k] = parity;
     }
 }
 
@@ -349,16 +381,11 @@ void BPTC19696::encodeErrorCheck()
 /// </summary>
 void BPTC19696::encodeInterleave()
 {
-    for (uint32_t i = 0U; i < 196U; i++)
-        m_rawData[i] = false;
+    uint64_t deInterData[4U] = { 0U, 0U, 0U, 0U };
+    for (uint32_t r = 0U; r < 13U; r++)
+        orBits(deInterData, (r * 15U) + 1U, 15U, m_deInterData[r]);
 
-    // The first bit is R(3) which is not used so can be ignored
-    for (uint32_t a = 0U; a < 196U; a++) {
-        // Calculate the interleave sequence
-        uint32_t interleaveSequence = (a * 181U) % 196U;
-        // Unshuffle the data
-        m_rawData[interleaveSequence] = m_deInterData[a];
-    }
+    permute(bptcTables().interleave, deInterData, m_rawData);
 }
 
 /// <summary>
@@ -368,36 +395,14 @@ void BPTC19696::encodeInterleave()
 void BPTC19696::encodeExtractBinary(uint8_t* data)
 {
     // First block
-    Utils::bitsToByteBE(m_rawData + 0U, data[0U]);
-    Utils::bitsToByteBE(m_rawData + 8U, data[1U]);
-    Utils::bitsToByteBE(m_rawData + 16U, data[2U]);
-    Utils::bitsToByteBE(m_rawData + 24U, data[3U]);
-    Utils::bitsToByteBE(m_rawData + 32U, data[4U]);
-    Utils::bitsToByteBE(m_rawData + 40U, data[5U]);
-    Utils::bitsToByteBE(m_rawData + 48U, data[6U]);
-    Utils::bitsToByteBE(m_rawData + 56U, data[7U]);
-    Utils::bitsToByteBE(m_rawData + 64U, data[8U]);
-    Utils::bitsToByteBE(m_rawData + 72U, data[9U]);
-    Utils::bitsToByteBE(m_rawData + 80U, data[10U]);
-    Utils::bitsToByteBE(m_rawData + 88U, data[11U]);
+    for (uint32_t i = 0U; i < 12U; i++)
+        data[i] = (uint8_t)getBits(m_rawData, i * 8U, 8U);
 
     // Handle the two bits
-    uint8_t byte;
-    Utils::bitsToByteBE(m_rawData + 96U, byte);
-    data[12U] = (data[12U] & 0x3FU) | ((byte >> 0) & 0xC0U);
-    data[20U] = (data[20U] & 0xFCU) | ((byte >> 4) & 0x03U);
+    data[12U] = (data[12U] & 0x3FU) | (uint8_t)(getBits(m_rawData, 96U, 2U) << 6);
+    data[20U] = (data[20U] & 0xFCU) | (uint8_t)getBits(m_rawData, 98U, 2U);
 
     // Second block
-    Utils::bitsToByteBE(m_rawData + 100U, data[21U]);
-    Utils::bitsToByteBE(m_rawData + 108U, data[22U]);
-    Utils::bitsToByteBE(m_rawData + 116U, data[23U]);
-    Utils::bitsToByteBE(m_rawData + 124U, data[24U]);
-    Utils::bitsToByteBE(m_rawData + 132U, data[25U]);
-    Utils::bitsToByteBE(m_rawData + 140U, data[26U]);
-    Utils::bitsToByteBE(m_rawData + 148U, data[27U]);
-    Utils::bitsToByteBE(m_rawData + 156U, data[28U]);
-    Utils::bitsToByteBE(m_rawData + 164U, data[29U]);
-    Utils::bitsToByteBE(m_rawData + 172U, data[30U]);
-    Utils::bitsToByteBE(m_rawData + 180U, data[31U]);
-    Utils::bitsToByteBE(m_rawData + 188U, data[32U]);
+    for (uint32_t i = 0U; i < 12U; i++)
+        data[21U + i] = (uint8_t)getBits(m_rawData, 100U + (i * 8U), 8U);
 }
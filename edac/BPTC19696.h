@@ -52,8 +52,8 @@ namespace edac
         void encode(const uint8_t* in, uint8_t* out);
 
     private:
-        bool* m_rawData;
-        bool* m_deInterData;
+        uint64_t m_rawData[4U];         // 196 interleaved bits, MSB first
+        uint16_t m_deInterData[13U];    // rows of the de-interleaved 13x15 matrix, column 0 in bit 14
 
         /// <summary></summary>
         void decodeExtractBinary(const uint8_t* in);
@@ -65,7 +65,7 @@ namespace edac
         void decodeExtractData(uint8_t* data) const;
 
         /// <summary></summary>
-        void encodeExtractData(const uint8_t* in) const;
+        void encodeExtractData(const uint8_t* in);
         /// <summary></summary>
         void encodeInterleave();
         /// <summary></summary>
@@ -38,6 +38,10 @@ using namespace edac;
 #include <cstdio>
 #include <cassert>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 // ---------------------------------------------------------------------------
 //  Constants
 // ---------------------------------------------------------------------------
@@ -1073,11 +1077,66 @@ static const uint32_t DECODING_TABLE_23127[] = {
     0x403000U, 0x080840U, 0x100044U, 0x011008U, 0x022800U, 0x004110U, 0x100040U, 0x100041U, 0x100042U, 0x440020U,
     0x011001U, 0x011000U, 0x080420U, 0x011002U, 0x100048U, 0x011004U, 0x204200U, 0x028080U };
 
-#define X22             0x00400000   /* vector representation of X^{22} */
-#define X11             0x00000800   /* vector representation of X^{11} */
-#define MASK12          0xfffff800   /* auxiliary vector for testing */
 #define GENPOL          0x00000c75   /* generator polinomial, g(x) */
 
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+//      Golay (23,12,7) syndromes by byte. The syndrome is the remainder of the
+//      pattern divided by GENPOL, which is linear in the pattern, so the
+//      syndrome of a 24-bit pattern is the XOR of its three byte entries.
+// ---------------------------------------------------------------------------
+
+struct Golay23127SyndromeTable {
+    uint32_t syndrome[3][256];
+
+    Golay23127SyndromeTable()
+    {
+        for (uint32_t n = 0U; n < 3U; n++) {
+            for (uint32_t v = 0U; v < 256U; v++) {
+                uint32_t s = 0U;
+                for (uint32_t t = 0U; t < 8U; t++) {
+                    if ((v >> t) & 1U)
+                        s ^= remainder(1U << ((n * 8U) + t));
+                }
+
+                syndrome[n][v] = s;
+            }
+        }
+    }
+
+    static uint32_t remainder(uint32_t pattern)
+    {
+        for (int bit = 23; bit >= 11; bit--) {
+            if (pattern & (1U << bit))
+                pattern ^= GENPOL << (bit - 11);
+        }
+
+        return pattern;
+    }
+};
+
+static const Golay23127SyndromeTable& syndromeTable()
+{
+    static const Golay23127SyndromeTable table;
+    return table;
+}
+
+#if defined(__AVX2__)
+/// <summary>
+/// Computes the Golay (23,12,7) syndromes of eight patterns.
+/// </summary>
+static inline __m256i getSyndromes23127(__m256i pattern)
+{
+    const Golay23127SyndromeTable& table = syndromeTable();
+    const __m256i byteMask = _mm256_set1_epi32(0xFF);
+
+    __m256i s0 = _mm256_i32gather_epi32((const int*)table.syndrome[0U], _mm256_and_si256(pattern, byteMask), 4);
+    __m256i s1 = _mm256_i32gather_epi32((const int*)table.syndrome[1U], _mm256_and_si256(_mm256_srli_epi32(pattern, 8), byteMask), 4);
+    __m256i s2 = _mm256_i32gather_epi32((const int*)table.syndrome[2U], _mm256_and_si256(_mm256_srli_epi32(pattern, 16), byteMask), 4);
+    return _mm256_xor_si256(_mm256_xor_si256(s0, s1), s2);
+}
+#endif // defined(__AVX2__)
+
 // ---------------------------------------------------------------------------
 //  Static Class Members
 // ---------------------------------------------------------------------------
@@ -1193,6 +1252,72 @@ void Golay24128::decode24128(uint8_t* data, const uint8_t* raw, uint32_t msglen)
     }
 }
 
+/// <summary>
+/// Decode a batch of Golay (23,12,7) FEC codewords.
+/// </summary>
+/// <param name="data">Data decoded from each codeword.</param>
+/// <param name="codes">Codewords to decode.</param>
+/// <param name="count">Number of codewords.</param>
+void Golay24128::decode23127(uint32_t* data, const uint32_t* codes, uint32_t count)
+{
+    assert(data != nullptr);
+    assert(codes != nullptr);
+
+    uint32_t i = 0U;
+#if defined(__AVX2__)
+    for (; i + 8U <= count; i += 8U) {
+        __m256i code = _mm256_loadu_si256((const __m256i*)(codes + i));
+        __m256i syndrome = getSyndromes23127(code);
+        __m256i error_pattern = _mm256_i32gather_epi32((const int*)DECODING_TABLE_23127, syndrome, 4);
+
+        code = _mm256_xor_si256(code, error_pattern);
+        _mm256_storeu_si256((__m256i*)(data + i), _mm256_srli_epi32(code, 11));
+    }
+#endif // defined(__AVX2__)
+
+    for (; i < count; i++)
+        data[i] = decode23127(codes[i]);
+}
+
+/// <summary>
+/// Decode a batch of Golay (24,12,8) FEC codewords.
+/// </summary>
+/// <param name="data">Data decoded from each codeword.</param>
+/// <param name="codes">Codewords to decode.</param>
+/// <param name="count">Number of codewords.</param>
+/// <param name="valid">Whether each codeword was decodable; may be null.</param>
+void Golay24128::decode24128(uint32_t* data, const uint32_t* codes, uint32_t count, bool* valid)
+{
+    assert(data != nullptr);
+    assert(codes != nullptr);
+
+    uint32_t i = 0U;
+#if defined(__AVX2__)
+    for (; i + 8U <= count; i += 8U) {
+        __m256i code = _mm256_loadu_si256((const __m256i*)(codes + i));
+        __m256i syndrome = getSyndromes23127(_mm256_srli_epi32(code, 1));
+        __m256i error_pattern = _mm256_i32gather_epi32((const int*)DECODING_TABLE_23127, syndrome, 4);
+
+        code = _mm256_xor_si256(code, _mm256_slli_epi32(error_pattern, 1));
+        _mm256_storeu_si256((__m256i*)(data + i), _mm256_srli_epi32(code, 12));
+
+        if (valid != nullptr) {
+            uint32_t s[8U], out[8U];
+            _mm256_storeu_si256((__m256i*)s, syndrome);
+            _mm256_storeu_si256((__m256i*)out, code);
+            for (uint32_t j = 0U; j < 8U; j++)
+                valid[i + j] = (Utils::countBits32(s[j]) < 3U) || !(Utils::countBits32(out[j]) & 1);
+        }
+    }
+#endif // defined(__AVX2__)
+
+    for (; i < count; i++) {
+        bool v = decode24128(codes[i], data[i]);
+        if (valid != nullptr)
+            valid[i] = v;
+    }
+}
+
 /// <summary>
 /// Encode Golay (23,12,7) FEC.
 /// </summary>
@@ -1276,6 +1401,52 @@ void Golay24128::encode24128(uint8_t* data, const uint8_t* raw, uint32_t msglen)
     }
 }
 
+/// <summary>
+/// Encode a batch of data with Golay (23,12,7) FEC.
+/// </summary>
+/// <param name="codes">Codeword for each data word.</param>
+/// <param name="data">Data to encode with Golay FEC.</param>
+/// <param name="count">Number of data words.</param>
+void Golay24128::encode23127(uint32_t* codes, const uint32_t* data, uint32_t count)
+{
+    assert(codes != nullptr);
+    assert(data != nullptr);
+
+    uint32_t i = 0U;
+#if defined(__AVX2__)
+    for (; i + 8U <= count; i += 8U) {
+        __m256i d = _mm256_loadu_si256((const __m256i*)(data + i));
+        _mm256_storeu_si256((__m256i*)(codes + i), _mm256_i32gather_epi32((const int*)ENCODING_TABLE_23127, d, 4));
+    }
+#endif // defined(__AVX2__)
+
+    for (; i < count; i++)
+        codes[i] = ENCODING_TABLE_23127[data[i]];
+}
+
+/// <summary>
+/// Encode a batch of data with Golay (24,12,8) FEC.
+/// </summary>
+/// <param name="codes">Codeword for each data word.</param>
+/// <param name="data">Data to encode with Golay FEC.</param>
+/// <param name="count">Number of data words.</param>
+void Golay24128::encode24128(uint32_t* codes, const uint32_t* data, uint32_t count)
+{
+    assert(codes != nullptr);
+    assert(data != nullptr);
+
+    uint32_t i = 0U;
+#if defined(__AVX2__)
+    for (; i + 8U <= count; i += 8U) {
+        __m256i d = _mm256_loadu_si256((const __m256i*)(data + i));
+        _mm256_storeu_si256((__m256i*)(codes + i), _mm256_i32gather_epi32((const int*)ENCODING_TABLE_24128, d, 4));
+    }
+#endif // defined(__AVX2__)
+
+    for (; i < count; i++)
+        codes[i] = ENCODING_TABLE_24128[data[i]];
+}
+
 // ---------------------------------------------------------------------------
 //  Private Static Class Members
 // ---------------------------------------------------------------------------
@@ -1296,16 +1467,7 @@ void Golay24128::encode24128(uint8_t* data, const uint8_t* raw, uint32_t msglen)
 /// <returns></returns>
 uint32_t Golay24128::getSyndrome23127(uint32_t pattern)
 {
-    uint32_t aux = X22;
-
-    if (pattern >= X11) {
-        while (pattern & MASK12) {
-            while (!(aux & pattern))
-                aux = aux >> 1;
-
-            pattern ^= (aux / X11) * GENPOL;
-        }
-    }
-
-    return pattern;
+    const Golay23127SyndromeTable& table = syndromeTable();
+    return table.syndrome[0U][pattern & 0xFFU] ^ table.syndrome[1U][(pattern >> 8) & 0xFFU] ^
+        table.syndrome[2U][(pattern >> 16) & 0xFFU];
 }
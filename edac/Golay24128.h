@@ -51,6 +51,10 @@ namespace edac
         static bool decode24128(uint8_t* bytes, uint32_t& out);
         /// <summary>Decode Golay (24,12,8) FEC.</summary>
         static void decode24128(uint8_t* data, const uint8_t* raw, uint32_t msglen);
+        /// <summary>Decode a batch of Golay (23,12,7) FEC codewords.</summary>
+        static void decode23127(uint32_t* data, const uint32_t* codes, uint32_t count);
+        /// <summary>Decode a batch of Golay (24,12,8) FEC codewords.</summary>
+        static void decode24128(uint32_t* data, const uint32_t* codes, uint32_t count, bool* valid);
 
         /// <summary>Encode Golay (23,12,7) FEC.</summary>
         static uint32_t encode23127(uint32_t data);
@@ -58,6 +62,10 @@ namespace edac
         static uint32_t encode24128(uint32_t data);
         /// <summary>Encode Golay (24,12,8) FEC.</summary>
         static void encode24128(uint8_t* data, const uint8_t* raw, uint32_t msglen);
+        /// <summary>Encode a batch of data with Golay (23,12,7) FEC.</summary>
+        static void encode23127(uint32_t* codes, const uint32_t* data, uint32_t count);
+        /// <summary>Encode a batch of data with Golay (24,12,8) FEC.</summary>
+        static void encode24128(uint32_t* codes, const uint32_t* data, uint32_t count);
 
     private:
         /// <summary></summary>
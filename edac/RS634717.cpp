@@ -37,6 +37,14 @@ using namespace edac;
 #include <cassert>
 #include <cstring>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RS_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RS_SIMD_NEON
+#endif
+
 // ---------------------------------------------------------------------------
 //  Constants
 // ---------------------------------------------------------------------------
@@ -117,6 +125,48 @@ const uint32_t rsGFlog[64] = {
     29, 60, 42, 21, 20, 59, 57, 58
 };
 
+const uint32_t RS_MAX_SYMBOLS = 36U;
+const uint32_t RS_MAX_ROOTS = 16U;
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+//      Decoder tables. exp[] repeats rsGFexp[] far enough that no index sum
+//      the decoder forms needs reducing modulo 63. syndrome[j][h][v] holds the
+//      contribution of symbol j to all 16 syndromes, S(i) += HB(j) * a^((i + 1)
+//      * (62 - j)), for the low (h = 0) and high (h = 1) three bits v of the
+//      symbol; this is the Horner evaluation of HB(x) at the roots of g(x)
+//      written out per symbol.
+// ---------------------------------------------------------------------------
+
+struct RS634717Tables {
+    uint8_t exp[63U * (RS_MAX_ROOTS + 2U)];
+    alignas(16) uint8_t syndrome[RS_MAX_SYMBOLS][2U][8U][RS_MAX_ROOTS];
+
+    RS634717Tables()
+    {
+        for (uint32_t i = 0U; i < sizeof(exp); i++)
+            exp[i] = (uint8_t)rsGFexp[i % 63U];
+
+        for (uint32_t j = 0U; j < RS_MAX_SYMBOLS; j++) {
+            for (uint32_t h = 0U; h < 2U; h++) {
+                for (uint32_t v = 0U; v < 8U; v++) {
+                    uint32_t hb = v << (h * 3U);
+                    for (uint32_t i = 0U; i < RS_MAX_ROOTS; i++) {
+                        syndrome[j][h][v][i] = (hb == 0U) ? 0U :
+                            exp[rsGFlog[hb] + (((i + 1U) * (62U - j)) % 63U)];
+                    }
+                }
+            }
+        }
+    }
+};
+
+static const RS634717Tables& rsTables()
+{
+    static const RS634717Tables tables;
+    return tables;
+}
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -324,13 +374,21 @@ uint8_t RS634717::gf6Mult(uint8_t a, uint8_t b) const
 bool RS634717::decode(uint8_t* data, const uint32_t bitLength, const int firstData, const int roots)
 {
     assert(data != nullptr);
+    assert(bitLength <= RS_MAX_SYMBOLS && (bitLength % 4U) == 0U);
+    assert(roots <= (int)RS_MAX_ROOTS);
 
-    uint8_t HB[63U];
-    ::memset(HB, 0x00U, 63U);
+    const RS634717Tables& tables = rsTables();
+    const uint8_t* gfExp = tables.exp;
 
-    uint32_t offset = 0U;
-    for (uint32_t i = 0U; i < bitLength; i++, offset += 6)
-        HB[i] = bin2Hex(data, offset);
+    // unpack the hexbits four to every three bytes
+    uint8_t HB[63U];
+    for (uint32_t i = 0U, n = 0U; i < bitLength; i += 4U, n += 3U) {
+        uint32_t w = (data[n] << 16) | (data[n + 1U] << 8) | data[n + 2U];
+        HB[i] = (w >> 18) & 0x3FU;
+        HB[i + 1U] = (w >> 12) & 0x3FU;
+        HB[i + 2U] = (w >> 6) & 0x3FU;
+        HB[i + 3U] = w & 0x3FU;
+    }
 
     // RS (63,63-nroots,nroots+1) decoder where nroots = number of parity bits
     //    rsDec(8, 39) rsDec(16, 27) rsDec(12, 39)
@@ -347,34 +405,41 @@ bool RS634717::decode(uint8_t* data, const uint32_t bitLength, const int firstDa
 
     int i, j, count, r, el, SynError, DiscrR, q, DegOmega, tmp, num1, num2, den, DegLambda;
 
-    // form the syndromes; i.e., evaluate HB(x) at roots of g(x)
-    for (i = 0; i <= nroots - 1; i++) {
-        S[i] = HB[0];
+    // form the syndromes; i.e., evaluate HB(x) at roots of g(x), all 16 at once
+    alignas(16) uint8_t syn[RS_MAX_ROOTS];
+#if defined(RS_SIMD_SSE2)
+    __m128i acc = _mm_setzero_si128();
+    for (uint32_t n = 0U; n < bitLength; n++) {
+        acc = _mm_xor_si128(acc, _mm_load_si128((const __m128i*)tables.syndrome[n][0U][HB[n] & 0x07U]));
+        acc = _mm_xor_si128(acc, _mm_load_si128((const __m128i*)tables.syndrome[n][1U][HB[n] >> 3]));
     }
-
-    for (j = 1; j <= 62; j++) {
-        for (i = 0; i <= nroots - 1; i++) {
-            if (S[i] == 0) {
-                S[i] = HB[j];
-            }
-            else {
-                S[i] = HB[j] ^ rsGFexp[(rsGFlog[S[i]] + i + 1) % 63];
-            }
-        }
+    _mm_store_si128((__m128i*)syn, acc);
+#elif defined(RS_SIMD_NEON)
+    uint8x16_t acc = vdupq_n_u8(0U);
+    for (uint32_t n = 0U; n < bitLength; n++) {
+        acc = veorq_u8(acc, vld1q_u8(tables.syndrome[n][0U][HB[n] & 0x07U]));
+        acc = veorq_u8(acc, vld1q_u8(tables.syndrome[n][1U][HB[n] >> 3]));
     }
+    vst1q_u8(syn, acc);
+#else
+    ::memset(syn, 0x00U, sizeof(syn));
+    for (uint32_t n = 0U; n < bitLength; n++) {
+        for (uint32_t k = 0U; k < RS_MAX_ROOTS; k++)
+            syn[k] ^= tables.syndrome[n][0U][HB[n] & 0x07U][k] ^ tables.syndrome[n][1U][HB[n] >> 3][k];
+    }
+#endif
 
     // convert syndromes to index form, checking for nonzero condition
     SynError = 0;
 
     for (i = 0; i <= nroots - 1; i++) {
-        SynError = SynError | S[i];
-        S[i] = rsGFlog[S[i]];
+        SynError = SynError | syn[i];
+        S[i] = rsGFlog[syn[i]];
     }
 
     if (SynError == 0) {
         // if syndrome is zero, rsData[] is a codeword and there are
         // no errors to correct. So return rsData[] unmodified
-        count = 0;
         return true;
     }
 
@@ -394,13 +459,12 @@ bool RS634717::decode(uint8_t* data, const uint32_t bitLength, const int firstDa
     el = 0;
     while (++r <= nroots) {
         // r is the step number
-        //r = r + 1;
         // compute discrepancy at the r-th step in poly-form
         DiscrR = 0;
 
         for (i = 0; i <= r - 1; i++) {
             if ((lambda[i] != 0) && (S[r - i - 1] != 63)) {
-                DiscrR = DiscrR ^ rsGFexp[(rsGFlog[lambda[i]] + S[r - i - 1]) % 63];
+                DiscrR = DiscrR ^ gfExp[rsGFlog[lambda[i]] + S[r - i - 1]];
             }
         }
 
@@ -420,7 +484,7 @@ bool RS634717::decode(uint8_t* data, const uint32_t bitLength, const int firstDa
 
             for (i = 0; i <= nroots - 1; i++) {
                 if (b[i] != 63) {
-                    t[i + 1] = lambda[i + 1] ^ rsGFexp[(DiscrR + b[i]) % 63];
+                    t[i + 1] = lambda[i + 1] ^ gfExp[DiscrR + b[i]];
                 }
                 else {
                     t[i + 1] = lambda[i + 1];
@@ -433,7 +497,9 @@ bool RS634717::decode(uint8_t* data, const uint32_t bitLength, const int firstDa
 
                 for (i = 0; i <= nroots; i++) {
                     if (lambda[i]) {
-                        b[i] = (rsGFlog[lambda[i]] - DiscrR + 63) % 63;
+                        b[i] = rsGFlog[lambda[i]] - DiscrR;
+                        if (b[i] < 0)
+                            b[i] += 63;
                     }
                     else {
                         b[i] = 63;
@@ -465,6 +531,9 @@ bool RS634717::decode(uint8_t* data, const uint32_t bitLength, const int firstDa
         }
     }
 
+    // the formal derivative below reads one term past lambda[nroots]
+    lambda[nroots + 1] = 63;
+
     // find roots of the error+erasure locator polynomial by Chien search
     for (i = 1; i <= nroots; i++) {
         reg[i] = lambda[i];
@@ -477,8 +546,10 @@ bool RS634717::decode(uint8_t* data, const uint32_t bitLength, const int firstDa
 
         for (j = DegLambda; j >= 1; j += -1) {
             if (reg[j] != 63) {
-                reg[j] = (reg[j] + j) % 63;
-                q = q ^ rsGFexp[reg[j]];
+                reg[j] += j;
+                if (reg[j] >= 63)
+                    reg[j] -= 63;
+                q = q ^ gfExp[reg[j]];
             }
         }
 
@@ -516,7 +587,7 @@ bool RS634717::decode(uint8_t* data, const uint32_t bitLength, const int firstDa
 
         for (/* j = j */; j >= 0; j += -1) {
             if ((S[i - j] != 63) && (lambda[j] != 63)) {
-                tmp = tmp ^ rsGFexp[(S[i - j] + lambda[j]) % 63];
+                tmp = tmp ^ gfExp[S[i - j] + lambda[j]];
             }
         }
 
@@ -538,11 +609,11 @@ bool RS634717::decode(uint8_t* data, const uint32_t bitLength, const int firstDa
 
         for (i = DegOmega; i >= 0; i += -1) {
             if (omega[i] != 63) {
-                num1 = num1 ^ rsGFexp[(omega[i] + i * root[j]) % 63];
+                num1 = num1 ^ gfExp[omega[i] + i * root[j]];
             }
         }
 
-        num2 = rsGFexp[0];
+        num2 = gfExp[0];
         den = 0;
 
         // lambda[i+1] for i even is the formal derivative lambda_pr of lambda[i]
@@ -555,7 +626,7 @@ bool RS634717::decode(uint8_t* data, const uint32_t bitLength, const int firstDa
 
         for (i = i & ~1; i >= 0; i += -2) {
             if (lambda[i + 1] != 63) {
-                den = den ^ rsGFexp[(lambda[i + 1] + i * root[j]) % 63];
+                den = den ^ gfExp[lambda[i + 1] + i * root[j]];
             }
         }
 
@@ -567,11 +638,11 @@ bool RS634717::decode(uint8_t* data, const uint32_t bitLength, const int firstDa
         if (num1 != 0) {
             if (locn[j] < firstData)
                 return false;
-            HB[locn[j]] = HB[locn[j]] ^ (rsGFexp[(rsGFlog[num1] + rsGFlog[num2] + 63 - rsGFlog[den]) % 63]);
+            HB[locn[j]] = HB[locn[j]] ^ gfExp[rsGFlog[num1] + rsGFlog[num2] + 63 - rsGFlog[den]];
         }
     }
 
-    offset = 0U;
+    uint32_t offset = 0U;
     for (uint32_t i = 0U; i < (uint32_t)nroots; i++, offset += 6)
         hex2Bin(HB[i], data, offset);
 
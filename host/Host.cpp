@@ -33,8 +33,10 @@
 #include "host/Host.h"
 #include "dmr/Transcode.h"
 #include "p25/Transcode.h"
+#include "vocoder/VocoderPool.h"
 #include "HostMain.h"
 #include "Log.h"
+#include "Reactor.h"
 #include "StopWatch.h"
 #include "Thread.h"
 #include "Utils.h"
@@ -53,6 +55,12 @@ using namespace network;
 #include <pwd.h>
 #endif
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t MAX_REACTOR_WAIT = 1000U;
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -70,6 +78,10 @@ Host::Host(const std::string& confFile) :
     m_p25GainAdjust(0.0f),
     m_dmrGainAdjust(0.0f),
     m_timeout(180U),
+    m_vocoderWorkers(2U),
+    m_transcodeMode(vocoder::TRANSCODE_PCM),
+    m_transcodeCompare(false),
+    m_floatFFT(false),
     m_identity(),
     m_latitude(0.0F),
     m_longitude(0.0F),
@@ -173,18 +185,35 @@ int Host::run()
     if (!ret)
         return EXIT_FAILURE;
 
+    // initialize the event reactor (on platforms without one the main loop polls)
+    Reactor reactor;
+    bool useReactor = reactor.open();
+    if (!useReactor) {
+        ::LogWarning(LOG_HOST, "Event reactor is unavailable, main loop will poll");
+    }
+
+    // initialize vocoder workers
+    std::unique_ptr<vocoder::VocoderPool> vocoderPool = new_unique(vocoder::VocoderPool, m_vocoderWorkers);
+    if (useReactor) {
+        vocoderPool->setReactor(&reactor);
+    }
+
+    ret = vocoderPool->start();
+    if (!ret)
+        return EXIT_FAILURE;
+
     // initialize DMR -> P25 transcoder
-    std::unique_ptr<dmr::Transcode> dmrSrcTranscoder = new_unique(dmr::Transcode, m_dstNetwork, m_srcNetwork, m_timeout, m_dstJitter, m_p25GainAdjust, m_tcDebug, m_tcVerbose);
+    std::unique_ptr<dmr::Transcode> dmrSrcTranscoder = new_unique(dmr::Transcode, m_dstNetwork, m_srcNetwork, vocoderPool.get(), m_timeout, m_dstJitter, m_p25GainAdjust, m_transcodeMode, m_transcodeCompare, m_floatFFT, m_tcDebug, m_tcVerbose);
     std::unique_ptr<dmr::Transcode> dmrDstTranscoder = nullptr;
     if (m_twoWayTranscode) {
-         dmrDstTranscoder = new_unique(dmr::Transcode, m_srcNetwork, m_dstNetwork, m_timeout, m_srcJitter, m_p25GainAdjust, m_tcDebug, m_tcVerbose);
+         dmrDstTranscoder = new_unique(dmr::Transcode, m_srcNetwork, m_dstNetwork, vocoderPool.get(), m_timeout, m_srcJitter, m_p25GainAdjust, m_transcodeMode, m_transcodeCompare, m_floatFFT, m_tcDebug, m_tcVerbose);
     }
 
     // initialize P25 -> DMR transcoder
-    std::unique_ptr<p25::Transcode> p25SrcTranscoder = new_unique(p25::Transcode, m_srcNetwork, m_dstNetwork, m_timeout, m_dmrGainAdjust, m_tcDebug, m_tcVerbose);
+    std::unique_ptr<p25::Transcode> p25SrcTranscoder = new_unique(p25::Transcode, m_srcNetwork, m_dstNetwork, vocoderPool.get(), m_timeout, m_dmrGainAdjust, m_transcodeMode, m_transcodeCompare, m_floatFFT, m_tcDebug, m_tcVerbose);
     std::unique_ptr<p25::Transcode> p25DstTranscoder = nullptr;
     if (m_twoWayTranscode) {
-        p25DstTranscoder = new_unique(p25::Transcode, m_dstNetwork, m_srcNetwork, m_timeout, m_dmrGainAdjust, m_tcDebug, m_tcVerbose);
+        p25DstTranscoder = new_unique(p25::Transcode, m_dstNetwork, m_srcNetwork, vocoderPool.get(), m_timeout, m_dmrGainAdjust, m_transcodeMode, m_transcodeCompare, m_floatFFT, m_tcDebug, m_tcVerbose);
     }
 
     StopWatch stopWatch;
@@ -252,8 +281,46 @@ int Host::run()
             killed = true;
         }
 
-        if (ms < 2U)
-            Thread::sleep(1U);
+        if (useReactor) {
+            // sleep until a socket is readable, vocoder work completes or the next timer is due
+            uint32_t timeout = 0U;
+            if (dmrSrcTranscoder != nullptr)
+                timeout = Timer::earliest(timeout, dmrSrcTranscoder->getNextDeadline());
+            if (p25SrcTranscoder != nullptr)
+                timeout = Timer::earliest(timeout, p25SrcTranscoder->getNextDeadline());
+            if (dmrDstTranscoder != nullptr)
+                timeout = Timer::earliest(timeout, dmrDstTranscoder->getNextDeadline());
+            if (p25DstTranscoder != nullptr)
+                timeout = Timer::earliest(timeout, p25DstTranscoder->getNextDeadline());
+            if (m_srcNetwork != nullptr)
+                timeout = Timer::earliest(timeout, m_srcNetwork->getNextDeadline());
+            if (m_dstNetwork != nullptr)
+                timeout = Timer::earliest(timeout, m_dstNetwork->getNextDeadline());
+
+            if (timeout == 0U || timeout > MAX_REACTOR_WAIT)
+                timeout = MAX_REACTOR_WAIT;
+
+            // frames already read from the sockets, or already due out, are processed on the next pass
+            if ((dmrSrcTranscoder != nullptr && dmrSrcTranscoder->hasRxData()) ||
+                (p25SrcTranscoder != nullptr && (p25SrcTranscoder->hasRxData() || p25SrcTranscoder->hasTxData())) ||
+                (dmrDstTranscoder != nullptr && dmrDstTranscoder->hasRxData()) ||
+                (p25DstTranscoder != nullptr && (p25DstTranscoder->hasRxData() || p25DstTranscoder->hasTxData())))
+                timeout = 0U;
+
+            // sockets may have been closed and reopened by the network clock
+            std::vector<int> fds;
+            if (m_srcNetwork != nullptr)
+                m_srcNetwork->getSocketFds(fds);
+            if (m_dstNetwork != nullptr)
+                m_dstNetwork->getSocketFds(fds);
+
+            reactor.setFds(fds);
+            reactor.wait(timeout);
+        }
+        else {
+            if (ms < 2U)
+                Thread::sleep(1U);
+        }
     }
 
     if (m_srcNetwork != nullptr) {
@@ -285,6 +352,11 @@ bool Host::readParams()
     m_tcDebug = systemConf["debug"].as<bool>(true);
     m_p25GainAdjust = systemConf["p25GainAdjust"].as<float>(0.0f);
     m_dmrGainAdjust = systemConf["dmrGainAdjust"].as<float>(2.5f);
+    m_vocoderWorkers = systemConf["vocoderWorkers"].as<uint32_t>(2U);
+    std::string transcodeMode = systemConf["transcodeMode"].as<std::string>("pcm");
+    m_transcodeMode = (transcodeMode == "parametric") ? vocoder::TRANSCODE_PARAMETRIC : vocoder::TRANSCODE_PCM;
+    m_transcodeCompare = systemConf["transcodeCompare"].as<bool>(false);
+    m_floatFFT = systemConf["floatFFT"].as<bool>(false);
 
     removeLockFile();
 
@@ -295,6 +367,10 @@ bool Host::readParams()
     LogInfo("    Two-way Transcode: %s", m_twoWayTranscode ? "enabled" : "disabled");
     LogInfo("    P25 Gain Adjust: %f", m_p25GainAdjust);
     LogInfo("    DMR Gain Adjust: %f", m_dmrGainAdjust);
+    LogInfo("    Vocoder Workers: %u", m_vocoderWorkers);
+    LogInfo("    Transcode Mode: %s", (m_transcodeMode == vocoder::TRANSCODE_PARAMETRIC) ? "parametric" : "pcm");
+    LogInfo("    Transcode A/B Compare: %s", m_transcodeCompare ? "enabled" : "disabled");
+    LogInfo("    Float FFT: %s", m_floatFFT ? "enabled" : "disabled");
 
     if (m_tcVerbose) {
         LogInfo("    Verbose: yes");
@@ -334,6 +410,7 @@ bool Host::createSrcNetwork()
     std::string password = networkConf["password"].as<std::string>();
     bool slot1 = networkConf["slot1"].as<bool>(true);
     bool slot2 = networkConf["slot2"].as<bool>(true);
+    uint32_t rxBatchSize = networkConf["rxBatchSize"].as<uint32_t>(DEFAULT_RX_BATCH_SIZE);
     bool debug = networkConf["debug"].as<bool>(false);
 
     LogInfo("Source Network Parameters");
@@ -347,6 +424,7 @@ bool Host::createSrcNetwork()
     LogInfo("    DMR Jitter: %ums", jitter);
     LogInfo("    Slot 1: %s", slot1 ? "enabled" : "disabled");
     LogInfo("    Slot 2: %s", slot2 ? "enabled" : "disabled");
+    LogInfo("    Rx Batch Size: %u", rxBatchSize);
 
     if (debug) {
         LogInfo("    Debug: yes");
@@ -354,7 +432,7 @@ bool Host::createSrcNetwork()
 
     m_srcJitter = jitter;
 
-    m_srcNetwork = new Network(address, port, local, id, password, true, debug, slot1, slot2);
+    m_srcNetwork = new Network(address, port, local, id, password, true, debug, slot1, slot2, rxBatchSize);
     m_srcNetwork->setMetadata(m_identity, 0, 0, 0.0F, 0.0F, 0, 0, 0, m_latitude, m_longitude, m_height, m_location);
 
     bool ret = m_srcNetwork->open();
@@ -384,6 +462,7 @@ bool Host::createDstNetwork()
     std::string password = networkConf["password"].as<std::string>();
     bool slot1 = networkConf["slot1"].as<bool>(true);
     bool slot2 = networkConf["slot2"].as<bool>(true);
+    uint32_t rxBatchSize = networkConf["rxBatchSize"].as<uint32_t>(DEFAULT_RX_BATCH_SIZE);
     bool debug = networkConf["debug"].as<bool>(false);
 
     LogInfo("Destination Network Parameters");
@@ -397,6 +476,7 @@ bool Host::createDstNetwork()
     LogInfo("    DMR Jitter: %ums", jitter);
     LogInfo("    Slot 1: %s", slot1 ? "enabled" : "disabled");
     LogInfo("    Slot 2: %s", slot2 ? "enabled" : "disabled");
+    LogInfo("    Rx Batch Size: %u", rxBatchSize);
 
     if (debug) {
         LogInfo("    Debug: yes");
@@ -404,7 +484,7 @@ bool Host::createDstNetwork()
 
     m_dstJitter = jitter;
 
-    m_dstNetwork = new Network(address, port, local, id, password, true, debug, slot1, slot2);
+    m_dstNetwork = new Network(address, port, local, id, password, true, debug, slot1, slot2, rxBatchSize);
     m_dstNetwork->setMetadata(m_identity, 0, 0, 0.0F, 0.0F, 0, 0, 0, m_latitude, m_longitude, m_height, m_location);
 
     bool ret = m_dstNetwork->open();
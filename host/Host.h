@@ -33,6 +33,7 @@
 
 #include "Defines.h"
 #include "network/Network.h"
+#include "vocoder/VocoderContext.h"
 #include "Timer.h"
 #include "yaml/Yaml.h"
 
@@ -68,6 +69,11 @@ private:
 
     uint32_t m_timeout;
 
+    uint32_t m_vocoderWorkers;
+    vocoder::TRANSCODE_MODE m_transcodeMode;
+    bool m_transcodeCompare;
+    bool m_floatFFT;
+
     std::string m_identity;
 
     float m_latitude;
@@ -68,8 +68,11 @@ BaseNetwork::BaseNetwork(uint32_t localPort, uint32_t id, bool duplex, bool debu
     m_salt(nullptr),
     m_streamId(nullptr),
     m_p25StreamId(0U),
-    m_rxDMRData(4000U, "DMR Net Buffer"),
-    m_rxP25Data(4000U, "P25 Net Buffer"),
+    m_rxDMRData(RX_QUEUE_LENGTH, "DMR Net Queue"),
+    m_rxP25Data(RX_QUEUE_LENGTH, "P25 Net Queue"),
+    m_p25Pool(P25_PACKET_POOL_COUNT, P25_PACKET_POOL_SIZE, "P25 Packet Pool"),
+    m_txBatch(nullptr),
+    m_txCount(0U),
     m_random()
 {
     assert(id > 1000U);
@@ -78,6 +81,14 @@ BaseNetwork::BaseNetwork(uint32_t localPort, uint32_t id, bool duplex, bool debu
     m_salt = new uint8_t[sizeof(uint32_t)];
     m_streamId = new uint32_t[2U];
 
+    m_txBatch = new UDPDatagram[TX_BATCH_SIZE];
+    for (uint32_t i = 0U; i < TX_BATCH_SIZE; i++) {
+        m_txBatch[i].buffer = new uint8_t[DATA_PACKET_LENGTH];
+        m_txBatch[i].size = DATA_PACKET_LENGTH;
+        m_txBatch[i].length = 0U;
+        m_txBatch[i].addrLen = 0U;
+    }
+
     std::random_device rd;
     std::mt19937 mt(rd());
     m_random = mt;
@@ -96,6 +107,12 @@ BaseNetwork::~BaseNetwork()
     delete[] m_buffer;
     delete[] m_salt;
     delete[] m_streamId;
+
+    for (uint32_t i = 0U; i < TX_BATCH_SIZE; i++) {
+        delete[] m_txBatch[i].buffer;
+    }
+
+    delete[] m_txBatch;
 }
 
 /// <summary>
@@ -108,13 +125,10 @@ bool BaseNetwork::readDMR(dmr::data::Data& data)
     if (m_status != NET_STAT_RUNNING && m_status != NET_STAT_MST_RUNNING)
         return false;
 
-    if (m_rxDMRData.isEmpty())
+    uint32_t length = 0U;
+    if (!m_rxDMRData.pop(m_buffer, DATA_PACKET_LENGTH, length))
         return false;
 
-    uint8_t length = 0U;
-    m_rxDMRData.getData(&length, 1U);
-    m_rxDMRData.getData(m_buffer, length);
-
     uint8_t seqNo = m_buffer[4U];
 
     uint32_t srcId = (m_buffer[5U] << 16) | (m_buffer[6U] << 8) | (m_buffer[7U] << 0);
@@ -170,69 +184,34 @@ bool BaseNetwork::readDMR(dmr::data::Data& data)
 }
 
 /// <summary>
-/// Reads P25 frame data from the P25 ring buffer.
+/// Reads P25 frame data from the P25 ring buffer into a pooled packet buffer.
 /// </summary>
-/// <param name="ret"></param>
+/// <remarks>The frame is valid until the view is released; an invalid view is returned
+/// if the packet pool is exhausted.</remarks>
+/// <param name="frame">View that receives the frame data.</param>
 /// <param name="control"></param>
 /// <param name="lsd"></param>
 /// <param name="duid"></param>
-/// <param name="len"></param>
-/// <returns></returns>
-uint8_t* BaseNetwork::readP25(bool& ret, p25::lc::LC& control, p25::data::LowSpeedData& lsd, uint8_t& duid, uint32_t& len)
+/// <returns>True, if a frame was read from the ring buffer, otherwise false.</returns>
+bool BaseNetwork::readP25(PacketView& frame, p25::lc::LC& control, p25::data::LowSpeedData& lsd, uint8_t& duid)
 {
-    if (m_status != NET_STAT_RUNNING && m_status != NET_STAT_MST_RUNNING) {
-        ret = false;
-        return nullptr;
-    }
-
-    if (m_rxP25Data.isEmpty()) {
-        ret = false;
-        return nullptr;
-    }
-
-    uint8_t length = 0U;
-    m_rxP25Data.getData(&length, 1U);
-    m_rxP25Data.getData(m_buffer, length);
-
-    uint8_t lco = m_buffer[4U];
-
-    uint32_t srcId = (m_buffer[5U] << 16) | (m_buffer[6U] << 8) | (m_buffer[7U] << 0);
-
-    uint32_t dstId = (m_buffer[8U] << 16) | (m_buffer[9U] << 8) | (m_buffer[10U] << 0);
-
-    uint8_t MFId = m_buffer[15U];
-
-    uint8_t lsd1 = m_buffer[20U];
-    uint8_t lsd2 = m_buffer[21U];
-
-    duid = m_buffer[22U];
-
-    if (m_debug) {
-        LogDebug(LOG_NET, "P25, lco = $%02X, MFId = $%02X, srcId = %u, dstId = %u, len = %u", lco, MFId, srcId, dstId, length);
-    }
+    frame.release();
 
-    control.setLCO(lco);
-    control.setSrcId(srcId);
-    control.setDstId(dstId);
-    control.setMFId(MFId);
+    uint32_t len = 0U;
+    if (!readP25Header(control, lsd, duid, len))
+        return false;
 
-    lsd.setLSD1(lsd1);
-    lsd.setLSD2(lsd2);
+    uint8_t* data = m_p25Pool.acquire();
+    if (data == nullptr)
+        return true;
 
-    uint8_t* data = nullptr;
-    len = m_buffer[23U];
-    if (len <= 24) {
-        data = new uint8_t[len];
-        ::memset(data, 0x00U, len);
-    }
-    else {
-        data = new uint8_t[len];
-        ::memset(data, 0x00U, len);
+    ::memset(data, 0x00U, len);
+    if (len > 24U) {
         ::memcpy(data, m_buffer + 24U, len);
     }
 
-    ret = true;
-    return data;
+    frame.attach(&m_p25Pool, data, len);
+    return true;
 }
 
 /// <summary>
@@ -331,6 +310,28 @@ bool BaseNetwork::writeP25TDU(const p25::lc::LC& control, const p25::data::LowSp
     return writeP25TDU(m_id, m_p25StreamId, control, lsd);
 }
 
+/// <summary>
+/// Writes all queued frames to the network.
+/// </summary>
+/// <remarks>Frames are queued by the write functions and sent together once per clock; callers
+/// with latency-critical frames may flush right after writing them.</remarks>
+/// <returns>True, if all queued frames were written to the network, otherwise false.</returns>
+bool BaseNetwork::flush()
+{
+    if (m_txCount == 0U)
+        return true;
+
+    bool ret = m_socket.write(m_txBatch, m_txCount);
+    m_txCount = 0U;
+
+    if (!ret) {
+        LogError(LOG_NET, "Socket has failed when writing data to the peer, retrying connection");
+        return false;
+    }
+
+    return true;
+}
+
 /// <summary>
 /// Resets the DMR ring buffer for the given slot.
 /// </summary>
@@ -362,9 +363,65 @@ void BaseNetwork::resetP25()
     m_rxP25Data.clear();
 }
 
+/// <summary>
+/// Gets the number of milliseconds until the next network timer expires.
+/// </summary>
+/// <returns>Milliseconds until the next timer expires, or zero if no timer is running.</returns>
+uint32_t BaseNetwork::getNextDeadline()
+{
+    return Timer::earliest(m_retryTimer.getRemainingMs(), m_timeoutTimer.getRemainingMs());
+}
+
 // ---------------------------------------------------------------------------
 //  Protected Class Members
 // ---------------------------------------------------------------------------
+/// <summary>
+/// Reads the next P25 frame from the P25 ring buffer and decodes its header.
+/// </summary>
+/// <remarks>The frame is left in m_buffer.</remarks>
+/// <param name="control"></param>
+/// <param name="lsd"></param>
+/// <param name="duid"></param>
+/// <param name="len">Length of the frame data following the header.</param>
+/// <returns>True, if a frame was read from the ring buffer, otherwise false.</returns>
+bool BaseNetwork::readP25Header(p25::lc::LC& control, p25::data::LowSpeedData& lsd, uint8_t& duid, uint32_t& len)
+{
+    if (m_status != NET_STAT_RUNNING && m_status != NET_STAT_MST_RUNNING)
+        return false;
+
+    uint32_t length = 0U;
+    if (!m_rxP25Data.pop(m_buffer, DATA_PACKET_LENGTH, length))
+        return false;
+
+    uint8_t lco = m_buffer[4U];
+
+    uint32_t srcId = (m_buffer[5U] << 16) | (m_buffer[6U] << 8) | (m_buffer[7U] << 0);
+
+    uint32_t dstId = (m_buffer[8U] << 16) | (m_buffer[9U] << 8) | (m_buffer[10U] << 0);
+
+    uint8_t MFId = m_buffer[15U];
+
+    uint8_t lsd1 = m_buffer[20U];
+    uint8_t lsd2 = m_buffer[21U];
+
+    duid = m_buffer[22U];
+
+    if (m_debug) {
+        LogDebug(LOG_NET, "P25, lco = $%02X, MFId = $%02X, srcId = %u, dstId = %u, len = %u", lco, MFId, srcId, dstId, length);
+    }
+
+    control.setLCO(lco);
+    control.setSrcId(srcId);
+    control.setDstId(dstId);
+    control.setMFId(MFId);
+
+    lsd.setLSD1(lsd1);
+    lsd.setLSD2(lsd2);
+
+    len = m_buffer[23U];
+    return true;
+}
+
 /// <summary>
 /// Writes DMR frame data to the network.
 /// </summary>
@@ -436,8 +493,7 @@ bool BaseNetwork::writeDMR(const uint32_t id, const uint32_t streamId, const dmr
     if (m_debug)
         Utils::dump(1U, "Network Transmitted, DMR", buffer, (DMR_PACKET_SIZE + PACKET_PAD));
 
-    for (uint32_t i = 0U; i < count; i++)
-        write(buffer, (DMR_PACKET_SIZE + PACKET_PAD));
+    queue(buffer, (DMR_PACKET_SIZE + PACKET_PAD), count);
 
     return true;
 }
@@ -561,7 +617,7 @@ bool BaseNetwork::writeP25LDU1(const uint32_t id, const uint32_t streamId, const
     if (m_debug)
         Utils::dump(1U, "Network Transmitted, P25 LDU1", buffer, (count + PACKET_PAD));
 
-    write(buffer, (count + PACKET_PAD));
+    queue(buffer, (count + PACKET_PAD));
 
     return true;
 }
@@ -690,7 +746,7 @@ bool BaseNetwork::writeP25LDU2(const uint32_t id, const uint32_t streamId, const
     if (m_debug)
         Utils::dump(1U, "Network Transmitted, P25 LDU2", buffer, (count + PACKET_PAD));
 
-    write(buffer, (count + PACKET_PAD));
+    queue(buffer, (count + PACKET_PAD));
 
     return true;
 }
@@ -738,7 +794,7 @@ bool BaseNetwork::writeP25TDU(const uint32_t id, const uint32_t streamId, const
     if (m_debug)
         Utils::dump(1U, "Network Transmitted, P25 TDU", buffer, (count + PACKET_PAD));
 
-    write(buffer, (count + PACKET_PAD));
+    queue(buffer, (count + PACKET_PAD));
 
     return true;
 }
@@ -765,3 +821,32 @@ bool BaseNetwork::write(const uint8_t* data, uint32_t length)
 
     return true;
 }
+
+/// <summary>
+/// Queues data to be written to the network on the next flush.
+/// </summary>
+/// <param name="buffer">Buffer to write to the network.</param>
+/// <param name="length">Length of buffer to write.</param>
+/// <param name="count">Number of times the buffer is written.</param>
+/// <returns>True, if buffer is queued, otherwise false.</returns>
+bool BaseNetwork::queue(const uint8_t* data, uint32_t length, uint32_t count)
+{
+    assert(data != nullptr);
+    assert(length > 0U && length <= DATA_PACKET_LENGTH);
+
+    bool ret = true;
+    for (uint32_t i = 0U; i < count; i++) {
+        if (m_txCount == TX_BATCH_SIZE) {
+            if (!flush())
+                ret = false;
+        }
+
+        UDPDatagram& dgram = m_txBatch[m_txCount++];
+        ::memcpy(dgram.buffer, data, length);
+        dgram.length = length;
+        dgram.address = m_addr;
+        dgram.addrLen = m_addrLen;
+    }
+
+    return ret;
+}
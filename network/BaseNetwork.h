@@ -37,8 +37,9 @@
 #include "dmr/data/Data.h"
 #include "p25/data/LowSpeedData.h"
 #include "p25/lc/LC.h"
+#include "network/PacketPool.h"
 #include "network/UDPSocket.h"
-#include "RingBuffer.h"
+#include "MessageQueue.h"
 #include "Timer.h"
 
 #include <string>
@@ -155,6 +156,12 @@ namespace network
     const uint32_t DMR_PACKET_SIZE = 55U;
     const uint32_t PACKET_PAD = 8U;
 
+    const uint32_t RX_QUEUE_LENGTH = 16384U;
+    const uint32_t TX_BATCH_SIZE = 16U;
+
+    const uint32_t P25_PACKET_POOL_COUNT = 8U;
+    const uint32_t P25_PACKET_POOL_SIZE = 256U;
+
     // ---------------------------------------------------------------------------
     //  Network Peer Connection Status
     // ---------------------------------------------------------------------------
@@ -193,8 +200,8 @@ namespace network
 
         /// <summary>Reads DMR frame data from the DMR ring buffer.</summary>
         virtual bool readDMR(dmr::data::Data& data);
-        /// <summary>Reads P25 frame data from the P25 ring buffer.</summary>
-        virtual uint8_t* readP25(bool& ret, p25::lc::LC& control, p25::data::LowSpeedData& lsd, uint8_t& duid, uint32_t& len);
+        /// <summary>Reads P25 frame data from the P25 ring buffer into a pooled packet buffer.</summary>
+        virtual bool readP25(PacketView& frame, p25::lc::LC& control, p25::data::LowSpeedData& lsd, uint8_t& duid);
 
         /// <summary>Writes DMR frame data to the network.</summary>
         virtual bool writeDMR(const dmr::data::Data& data);
@@ -205,6 +212,9 @@ namespace network
         /// <summary>Writes P25 TDU frame data to the network.</summary>
         virtual bool writeP25TDU(const p25::lc::LC& control, const p25::data::LowSpeedData& lsd);
 
+        /// <summary>Writes all queued frames to the network.</summary>
+        bool flush();
+
         /// <summary>Updates the timer by the passed number of milliseconds.</summary>
         virtual void clock(uint32_t ms) = 0;
 
@@ -219,7 +229,19 @@ namespace network
         /// <summary>Resets the P25 ring buffer.</summary>
         virtual void resetP25();
 
+        /// <summary>Gets the number of milliseconds until the next network timer expires.</summary>
+        virtual uint32_t getNextDeadline();
+        /// <summary>Gets the descriptors of the network sockets.</summary>
+        void getSocketFds(std::vector<int>& fds) const { m_socket.getFds(fds); }
+        /// <summary>Helper to return whether received DMR frames are waiting to be read.</summary>
+        bool hasDMRData() const { return isRunning() && m_rxDMRData.hasData(); }
+        /// <summary>Helper to return whether received P25 frames are waiting to be read.</summary>
+        bool hasP25Data() const { return isRunning() && m_rxP25Data.hasData(); }
+
     protected:
+        /// <summary>Helper to return whether the network is in a state where received frames are read.</summary>
+        bool isRunning() const { return m_status == NET_STAT_RUNNING || m_status == NET_STAT_MST_RUNNING; }
+
         uint32_t m_id;
 
         bool m_slot1;
@@ -242,11 +264,18 @@ namespace network
         uint32_t* m_streamId;
         uint32_t m_p25StreamId;
 
-        RingBuffer<uint8_t> m_rxDMRData;
-        RingBuffer<uint8_t> m_rxP25Data;
+        MessageQueue m_rxDMRData;
+        MessageQueue m_rxP25Data;
+        PacketPool m_p25Pool;
+
+        UDPDatagram* m_txBatch;
+        uint32_t m_txCount;
 
         std::mt19937 m_random;
 
+        /// <summary>Reads the next P25 frame from the P25 ring buffer and decodes its header.</summary>
+        bool readP25Header(p25::lc::LC& control, p25::data::LowSpeedData& lsd, uint8_t& duid, uint32_t& len);
+
         /// <summary>Writes DMR frame data to the network.</summary>
         bool writeDMR(const uint32_t id, const uint32_t streamId, const dmr::data::Data& data);
         /// <summary>Writes P25 LDU1 frame data to the network.</summary>
@@ -258,6 +287,8 @@ namespace network
 
         /// <summary>Writes data to the network.</summary>
         virtual bool write(const uint8_t* data, uint32_t length);
+        /// <summary>Queues data to be written to the network on the next flush.</summary>
+        bool queue(const uint8_t* data, uint32_t length, uint32_t count = 1U);
     };
 } // namespace network
 
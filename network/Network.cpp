@@ -56,13 +56,16 @@ using namespace network;
 /// <param name="duplex">Flag indicating full-duplex operation.</param>
 /// <param name="slot1">Flag indicating whether DMR slot 1 is enabled for network traffic.</param>
 /// <param name="slot2">Flag indicating whether DMR slot 2 is enabled for network traffic.</param>
+/// <param name="rxBatchSize">Number of datagrams read from the socket per receive call.</param>
 Network::Network(const std::string& address, uint32_t port, uint32_t local, uint32_t id, const std::string& password,
-    bool duplex, bool debug, bool slot1, bool slot2) :
+    bool duplex, bool debug, bool slot1, bool slot2, uint32_t rxBatchSize) :
     BaseNetwork(local, id, duplex, debug, slot1, slot2),
     m_address(address),
     m_port(port),
     m_password(password),
     m_enabled(false),
+    m_rxBatchSize(rxBatchSize),
+    m_rxBatch(nullptr),
     m_identity(),
     m_rxFrequency(0U),
     m_txFrequency(0U),
@@ -79,6 +82,19 @@ Network::Network(const std::string& address, uint32_t port, uint32_t local, uint
     assert(!address.empty());
     assert(port > 0U);
     assert(!password.empty());
+
+    if (m_rxBatchSize == 0U)
+        m_rxBatchSize = 1U;
+    if (m_rxBatchSize > UDP_BATCH_MAX)
+        m_rxBatchSize = UDP_BATCH_MAX;
+
+    m_rxBatch = new UDPDatagram[m_rxBatchSize];
+    for (uint32_t i = 0U; i < m_rxBatchSize; i++) {
+        m_rxBatch[i].buffer = new uint8_t[DATA_PACKET_LENGTH];
+        m_rxBatch[i].size = DATA_PACKET_LENGTH;
+        m_rxBatch[i].length = 0U;
+        m_rxBatch[i].addrLen = 0U;
+    }
 }
 
 /// <summary>
@@ -86,7 +102,11 @@ Network::Network(const std::string& address, uint32_t port, uint32_t local, uint
 /// </summary>
 Network::~Network()
 {
-    /* stub */
+    for (uint32_t i = 0U; i < m_rxBatchSize; i++) {
+        delete[] m_rxBatch[i].buffer;
+    }
+
+    delete[] m_rxBatch;
 }
 
 /// <summary>
@@ -157,109 +177,26 @@ void Network::clock(uint32_t ms)
         return;
     }
 
-    sockaddr_storage address;
-    unsigned int addrLen;
-    int length = m_socket.read(m_buffer, DATA_PACKET_LENGTH, address, addrLen);
-    if (length < 0) {
-        LogError(LOG_NET, "Socket has failed, retrying connection to the master");
-        close();
-        open();
-        return;
-    }
-
-    if (m_debug && length > 0)
-        Utils::dump(1U, "Network Received", m_buffer, length);
+    // send the frames queued since the last clock
+    flush();
 
-    if (length > 0) {
-        if (!UDPSocket::match(m_addr, address)) {
-            LogError(LOG_NET, "Packet received from an invalid source");
+    // drain everything pending on the socket before servicing the timers
+    while (true) {
+        int count = m_socket.read(m_rxBatch, m_rxBatchSize);
+        if (count < 0) {
+            LogError(LOG_NET, "Socket has failed, retrying connection to the master");
+            close();
+            open();
             return;
         }
 
-        if (::memcmp(m_buffer, TAG_DMR_DATA, 4U) == 0) {
-            if (m_enabled) {
-                if (m_debug)
-                    Utils::dump(1U, "Network Received, DMR", m_buffer, length);
-
-                uint8_t len = length;
-                m_rxDMRData.addData(&len, 1U);
-                m_rxDMRData.addData(m_buffer, len);
-            }
-        }
-        else if (::memcmp(m_buffer, TAG_P25_DATA, 4U) == 0) {
-            if (m_enabled) {
-                if (m_debug)
-                    Utils::dump(1U, "Network Received, P25", m_buffer, length);
-
-                uint8_t len = length;
-                m_rxP25Data.addData(&len, 1U);
-                m_rxP25Data.addData(m_buffer, len);
-            }
-        }
-        else if (::memcmp(m_buffer, TAG_MASTER_WL_RID, 7U) == 0) {
-            // ignore
-        }
-        else if (::memcmp(m_buffer, TAG_MASTER_BL_RID, 7U) == 0) {
-            // ignore
-        }
-        else if (::memcmp(m_buffer, TAG_MASTER_ACTIVE_TGS, 6U) == 0) {
-            // ignore
-        }
-        else if (::memcmp(m_buffer, TAG_MASTER_DEACTIVE_TGS, 7U) == 0) {
-            // ignore
-        }
-        else if (::memcmp(m_buffer, TAG_MASTER_NAK, 6U) == 0) {
-            if (m_status == NET_STAT_RUNNING) {
-                LogWarning(LOG_NET, "Master returned a NAK; attemping to relogin ...");
-                m_status = NET_STAT_WAITING_LOGIN;
-                m_timeoutTimer.start();
-                m_retryTimer.start();
-            }
-            else {
-                LogError(LOG_NET, "Master returned a NAK; network reconnect ...");
-                close();
-                open();
+        for (int i = 0; i < count; i++) {
+            if (!processPacket(m_rxBatch[i]))
                 return;
-            }
-        }
-        else if (::memcmp(m_buffer, TAG_REPEATER_ACK, 6U) == 0) {
-            switch (m_status) {
-                case NET_STAT_WAITING_LOGIN:
-                    LogDebug(LOG_NET, "Sending authorisation");
-                    ::memcpy(m_salt, m_buffer + 6U, sizeof(uint32_t));
-                    writeAuthorisation();
-                    m_status = NET_STAT_WAITING_AUTHORISATION;
-                    m_timeoutTimer.start();
-                    m_retryTimer.start();
-                    break;
-                case NET_STAT_WAITING_AUTHORISATION:
-                    LogDebug(LOG_NET, "Sending configuration");
-                    writeConfig();
-                    m_status = NET_STAT_WAITING_CONFIG;
-                    m_timeoutTimer.start();
-                    m_retryTimer.start();
-                    break;
-                case NET_STAT_WAITING_CONFIG:
-                    LogMessage(LOG_NET, "Logged into the master successfully");
-                    m_status = NET_STAT_RUNNING;
-                    m_timeoutTimer.start();
-                    m_retryTimer.start();
-                    break;
-                default:
-                    break;
-            }
-        }
-        else if (::memcmp(m_buffer, TAG_MASTER_CLOSING, 5U) == 0) {
-            LogError(LOG_NET, "Master is closing down");
-            close();
-            open();
-        }
-        else if (::memcmp(m_buffer, TAG_MASTER_PONG, 7U) == 0) {
-            m_timeoutTimer.start();
-        }
-        else {
-            Utils::dump("Unknown packet from the master", m_buffer, length);
         }
+
+        if ((uint32_t)count < m_rxBatchSize)
+            break;
     }
 
     m_retryTimer.clock(ms);
@@ -331,6 +268,8 @@ void Network::close()
         LogMessage(LOG_NET, "Closing Network");
 
     if (m_status == NET_STAT_RUNNING) {
+        flush();
+
         uint8_t buffer[9U];
         ::memcpy(buffer + 0U, TAG_REPEATER_CLOSING, 5U);
         __SET_UINT32(m_id, buffer, 5U);
@@ -348,6 +287,111 @@ void Network::close()
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
+/// <summary>
+/// Processes a single datagram received from the master.
+/// </summary>
+/// <param name="dgram"></param>
+/// <returns>True, if the remaining datagrams may be processed, otherwise false if the connection was reset.</returns>
+bool Network::processPacket(const UDPDatagram& dgram)
+{
+    uint8_t* buffer = dgram.buffer;
+    uint32_t length = dgram.length;
+
+    if (m_debug && length > 0)
+        Utils::dump(1U, "Network Received", buffer, length);
+
+    if (length > 0) {
+        if (!UDPSocket::match(m_addr, dgram.address)) {
+            LogError(LOG_NET, "Packet received from an invalid source");
+            return true;
+        }
+
+        if (::memcmp(buffer, TAG_DMR_DATA, 4U) == 0) {
+            if (m_enabled) {
+                if (m_debug)
+                    Utils::dump(1U, "Network Received, DMR", buffer, length);
+
+                m_rxDMRData.push(buffer, length);
+            }
+        }
+        else if (::memcmp(buffer, TAG_P25_DATA, 4U) == 0) {
+            if (m_enabled) {
+                if (m_debug)
+                    Utils::dump(1U, "Network Received, P25", buffer, length);
+
+                m_rxP25Data.push(buffer, length);
+            }
+        }
+        else if (::memcmp(buffer, TAG_MASTER_WL_RID, 7U) == 0) {
+            // ignore
+        }
+        else if (::memcmp(buffer, TAG_MASTER_BL_RID, 7U) == 0) {
+            // ignore
+        }
+        else if (::memcmp(buffer, TAG_MASTER_ACTIVE_TGS, 6U) == 0) {
+            // ignore
+        }
+        else if (::memcmp(buffer, TAG_MASTER_DEACTIVE_TGS, 7U) == 0) {
+            // ignore
+        }
+        else if (::memcmp(buffer, TAG_MASTER_NAK, 6U) == 0) {
+            if (m_status == NET_STAT_RUNNING) {
+                LogWarning(LOG_NET, "Master returned a NAK; attemping to relogin ...");
+                m_status = NET_STAT_WAITING_LOGIN;
+                m_timeoutTimer.start();
+                m_retryTimer.start();
+            }
+            else {
+                LogError(LOG_NET, "Master returned a NAK; network reconnect ...");
+                close();
+                open();
+                return false;
+            }
+        }
+        else if (::memcmp(buffer, TAG_REPEATER_ACK, 6U) == 0) {
+            switch (m_status) {
+                case NET_STAT_WAITING_LOGIN:
+                    LogDebug(LOG_NET, "Sending authorisation");
+                    ::memcpy(m_salt, buffer + 6U, sizeof(uint32_t));
+                    writeAuthorisation();
+                    m_status = NET_STAT_WAITING_AUTHORISATION;
+                    m_timeoutTimer.start();
+                    m_retryTimer.start();
+                    break;
+                case NET_STAT_WAITING_AUTHORISATION:
+                    LogDebug(LOG_NET, "Sending configuration");
+                    writeConfig();
+                    m_status = NET_STAT_WAITING_CONFIG;
+                    m_timeoutTimer.start();
+                    m_retryTimer.start();
+                    break;
+                case NET_STAT_WAITING_CONFIG:
+                    LogMessage(LOG_NET, "Logged into the master successfully");
+                    m_status = NET_STAT_RUNNING;
+                    m_timeoutTimer.start();
+                    m_retryTimer.start();
+                    break;
+                default:
+                    break;
+            }
+        }
+        else if (::memcmp(buffer, TAG_MASTER_CLOSING, 5U) == 0) {
+            LogError(LOG_NET, "Master is closing down");
+            close();
+            open();
+            return false;
+        }
+        else if (::memcmp(buffer, TAG_MASTER_PONG, 7U) == 0) {
+            m_timeoutTimer.start();
+        }
+        else {
+            Utils::dump("Unknown packet from the master", buffer, length);
+        }
+    }
+
+    return true;
+}
+
 /// <summary>
 /// Writes login request to the network.
 /// </summary>
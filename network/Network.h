@@ -33,12 +33,19 @@
 
 #include "Defines.h"
 #include "network/BaseNetwork.h"
+#include "network/UDPSocket.h"
 
 #include <string>
 #include <cstdint>
 
 namespace network
 {
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t DEFAULT_RX_BATCH_SIZE = 16U;
+
     // ---------------------------------------------------------------------------
     //  Class Declaration
     //      Implements the core networking logic.
@@ -47,7 +54,8 @@ namespace network
     class HOST_SW_API Network : public BaseNetwork {
     public:
         /// <summary>Initializes a new instance of the Network class.</summary>
-        Network(const std::string& address, uint32_t port, uint32_t local, uint32_t id, const std::string& password, bool duplex, bool debug, bool slot1, bool slot2);
+        Network(const std::string& address, uint32_t port, uint32_t local, uint32_t id, const std::string& password, bool duplex, bool debug, bool slot1, bool slot2,
+            uint32_t rxBatchSize = DEFAULT_RX_BATCH_SIZE);
         /// <summary>Finalizes a instance of the Network class.</summary>
         ~Network();
 
@@ -77,6 +85,9 @@ namespace network
 
         bool m_enabled;
 
+        uint32_t m_rxBatchSize;
+        UDPDatagram* m_rxBatch;
+
         /** station metadata */
         std::string m_identity;
         uint32_t m_rxFrequency;
@@ -93,6 +104,9 @@ namespace network
         int m_height;
         std::string m_location;
 
+        /// <summary>Processes a single datagram received from the master.</summary>
+        bool processPacket(const UDPDatagram& dgram);
+
         /// <summary>Writes login request to the network.</summary>
         bool writeLogin();
         /// <summary>Writes network authentication challenge.</summary>
@@ -0,0 +1,140 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "network/PacketPool.h"
+#include "Log.h"
+
+using namespace network;
+
+#include <cassert>
+#include <utility>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+/// <summary>
+/// Attaches a pooled buffer to this view, releasing any buffer previously held.
+/// </summary>
+/// <param name="pool">Pool the buffer belongs to.</param>
+/// <param name="data">Buffer taken from the pool.</param>
+/// <param name="length">Length of the frame data in the buffer.</param>
+void PacketView::attach(PacketPool* pool, uint8_t* data, uint32_t length)
+{
+    release();
+
+    m_pool = pool;
+    m_data = data;
+    m_length = length;
+}
+
+/// <summary>
+/// Returns the held buffer to its pool.
+/// </summary>
+void PacketView::release()
+{
+    if (m_pool != nullptr && m_data != nullptr) {
+        m_pool->release(m_data);
+    }
+
+    m_pool = nullptr;
+    m_data = nullptr;
+    m_length = 0U;
+}
+
+/// <summary>
+/// Exchanges the buffers held by this view and another view.
+/// </summary>
+/// <param name="view">View to exchange buffers with.</param>
+void PacketView::swap(PacketView& view)
+{
+    std::swap(m_pool, view.m_pool);
+    std::swap(m_data, view.m_data);
+    std::swap(m_length, view.m_length);
+}
+
+/// <summary>
+/// Initializes a new instance of the PacketPool class.
+/// </summary>
+/// <param name="count">Number of buffers in the pool.</param>
+/// <param name="size">Size of each buffer.</param>
+/// <param name="name">Name of the pool.</param>
+PacketPool::PacketPool(uint32_t count, uint32_t size, const char* name) :
+    m_count(count),
+    m_size(size),
+    m_name(name),
+    m_storage(nullptr),
+    m_free(nullptr),
+    m_freeCount(0U)
+{
+    assert(count > 0U);
+    assert(size > 0U);
+
+    m_storage = new uint8_t[count * size];
+
+    // free buffers are kept as a stack, so the most recently released (and cache warm)
+    // buffer is handed out next
+    m_free = new uint8_t*[count];
+    for (uint32_t i = 0U; i < count; i++) {
+        m_free[i] = m_storage + (i * size);
+    }
+
+    m_freeCount = count;
+}
+
+/// <summary>
+/// Finalizes a instance of the PacketPool class.
+/// </summary>
+PacketPool::~PacketPool()
+{
+    delete[] m_free;
+    delete[] m_storage;
+}
+
+/// <summary>
+/// Takes a buffer from the pool.
+/// </summary>
+/// <returns>Buffer of getSize() bytes, or nullptr if every buffer is in use.</returns>
+uint8_t* PacketPool::acquire()
+{
+    if (m_freeCount == 0U) {
+        LogError(LOG_NET, "%s, pool exhausted, %u buffers in use", m_name, m_count);
+        return nullptr;
+    }
+
+    return m_free[--m_freeCount];
+}
+
+/// <summary>
+/// Returns a buffer to the pool.
+/// </summary>
+/// <param name="buffer">Buffer previously taken from this pool.</param>
+void PacketPool::release(uint8_t* buffer)
+{
+    assert(buffer >= m_storage && buffer < m_storage + (m_count * m_size));
+    assert(m_freeCount < m_count);
+
+    m_free[m_freeCount++] = buffer;
+}
@@ -0,0 +1,109 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__PACKET_POOL_H__)
+#define __PACKET_POOL_H__
+
+#include "Defines.h"
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Class Prototypes
+    // ---------------------------------------------------------------------------
+    class HOST_SW_API PacketPool;
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Represents a frame held in a pooled packet buffer. The buffer is handed
+    //      back to its pool when the view is released or goes out of scope.
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API PacketView {
+    public:
+        /// <summary>Initializes a new instance of the PacketView class.</summary>
+        PacketView() : m_pool(nullptr), m_data(nullptr), m_length(0U) { /* stub */ }
+        /// <summary>Finalizes a instance of the PacketView class.</summary>
+        ~PacketView() { release(); }
+
+        /// <summary>Attaches a pooled buffer to this view, releasing any buffer previously held.</summary>
+        void attach(PacketPool* pool, uint8_t* data, uint32_t length);
+        /// <summary>Returns the held buffer to its pool.</summary>
+        void release();
+        /// <summary>Exchanges the buffers held by this view and another view.</summary>
+        void swap(PacketView& view);
+
+        /// <summary>Gets the frame data.</summary>
+        uint8_t* get() const { return m_data; }
+        /// <summary>Gets the length of the frame data.</summary>
+        uint32_t getLength() const { return m_length; }
+        /// <summary>Helper to return whether this view holds a buffer.</summary>
+        bool isValid() const { return m_data != nullptr; }
+
+    private:
+        PacketPool* m_pool;
+        uint8_t* m_data;
+        uint32_t m_length;
+
+        PacketView(const PacketView&) = delete;
+        PacketView& operator=(const PacketView&) = delete;
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Implements a fixed-size pool of packet buffers, allocated once up front
+    //      so that frames on the voice path never touch the heap. The pool is not
+    //      locked; it and every view of its buffers belong to the thread reading
+    //      the network.
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API PacketPool {
+    public:
+        /// <summary>Initializes a new instance of the PacketPool class.</summary>
+        PacketPool(uint32_t count, uint32_t size, const char* name);
+        /// <summary>Finalizes a instance of the PacketPool class.</summary>
+        ~PacketPool();
+
+        /// <summary>Takes a buffer from the pool.</summary>
+        uint8_t* acquire();
+        /// <summary>Returns a buffer to the pool.</summary>
+        void release(uint8_t* buffer);
+
+        /// <summary>Gets the size of each buffer in the pool.</summary>
+        uint32_t getSize() const { return m_size; }
+
+    private:
+        uint32_t m_count;
+        uint32_t m_size;
+        const char* m_name;
+
+        uint8_t* m_storage;
+
+        uint8_t** m_free;
+        uint32_t m_freeCount;
+    };
+} // namespace network
+
+#endif // __PACKET_POOL_H__
@@ -259,6 +259,90 @@ int UDPSocket::read(uint8_t* buffer, uint32_t length, sockaddr_storage& address,
     return len;
 }
 
+/// <summary>
+/// Read a batch of datagrams from the UDP socket.
+/// </summary>
+/// <remarks>This never blocks; it returns as soon as no more datagrams are pending, or once
+/// all the given datagram slots have been filled.</remarks>
+/// <param name="datagrams">Datagram slots to receive into.</param>
+/// <param name="count">Number of datagram slots.</param>
+/// <returns>Number of datagrams read, or -1 if the socket failed.</returns>
+int UDPSocket::read(UDPDatagram* datagrams, uint32_t count)
+{
+    assert(datagrams != nullptr);
+    assert(count > 0U);
+
+    uint32_t total = 0U;
+
+#if defined(__linux__)
+    struct mmsghdr msgs[UDP_BATCH_MAX];
+    struct iovec iov[UDP_BATCH_MAX];
+
+    for (int i = 0; i < UDP_SOCKET_MAX && total < count; i++) {
+        // round robin
+        int index = (i + m_counter) % UDP_SOCKET_MAX;
+        if (m_fd[index] < 0)
+            continue;
+
+        uint32_t n = count - total;
+        if (n > UDP_BATCH_MAX)
+            n = UDP_BATCH_MAX;
+
+        ::memset(msgs, 0x00U, sizeof(struct mmsghdr) * n);
+        for (uint32_t j = 0U; j < n; j++) {
+            UDPDatagram& dgram = datagrams[total + j];
+            iov[j].iov_base = dgram.buffer;
+            iov[j].iov_len = dgram.size;
+
+            msgs[j].msg_hdr.msg_name = &dgram.address;
+            msgs[j].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            msgs[j].msg_hdr.msg_iov = &iov[j];
+            msgs[j].msg_hdr.msg_iovlen = 1U;
+        }
+
+        int ret = ::recvmmsg(m_fd[index], msgs, n, MSG_DONTWAIT, nullptr);
+        if (ret < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+                continue;
+
+            LogError(LOG_NET, "Error returned from recvmmsg, err: %d", errno);
+
+            if (errno == ENOTSOCK) {
+                LogMessage(LOG_NET, "Re-opening UDP port on %u", m_port[index]);
+                close();
+                open();
+            }
+
+            // hand back whatever was already read; the failure will surface on the next read
+            return (total > 0U) ? (int)total : -1;
+        }
+
+        for (int j = 0; j < ret; j++) {
+            datagrams[total + j].length = msgs[j].msg_len;
+            datagrams[total + j].addrLen = msgs[j].msg_hdr.msg_namelen;
+        }
+
+        total += (uint32_t)ret;
+    }
+
+    m_counter++;
+#else
+    while (total < count) {
+        UDPDatagram& dgram = datagrams[total];
+        int len = read(dgram.buffer, dgram.size, dgram.address, dgram.addrLen);
+        if (len < 0)
+            return (total > 0U) ? (int)total : -1;
+        if (len == 0)
+            break;
+
+        dgram.length = (uint32_t)len;
+        total++;
+    }
+#endif
+
+    return (int)total;
+}
+
 /// <summary>
 /// Write data to the UDP socket.
 /// </summary>
@@ -305,6 +389,82 @@ bool UDPSocket::write(const uint8_t* buffer, uint32_t length, const sockaddr_sto
     return result;
 }
 
+/// <summary>
+/// Write a batch of datagrams to the UDP socket.
+/// </summary>
+/// <param name="datagrams">Datagrams to write; each is sent to its own address.</param>
+/// <param name="count">Number of datagrams.</param>
+/// <returns>True, if every datagram was written, otherwise false.</returns>
+bool UDPSocket::write(const UDPDatagram* datagrams, uint32_t count)
+{
+    assert(datagrams != nullptr);
+
+    if (count == 0U)
+        return true;
+
+#if defined(__linux__)
+    struct mmsghdr msgs[UDP_BATCH_MAX];
+    struct iovec iov[UDP_BATCH_MAX];
+
+    uint32_t written = 0U;
+    for (int i = 0; i < UDP_SOCKET_MAX; i++) {
+        if (m_fd[i] < 0)
+            continue;
+
+        uint32_t offset = 0U;
+        while (offset < count) {
+            // gather the datagrams addressed to this socket's family
+            uint32_t n = 0U;
+            for (; offset < count && n < UDP_BATCH_MAX; offset++) {
+                const UDPDatagram& dgram = datagrams[offset];
+                if (m_af[i] != dgram.address.ss_family)
+                    continue;
+
+                iov[n].iov_base = dgram.buffer;
+                iov[n].iov_len = dgram.length;
+
+                ::memset(&msgs[n], 0x00U, sizeof(struct mmsghdr));
+                msgs[n].msg_hdr.msg_name = (void*)&dgram.address;
+                msgs[n].msg_hdr.msg_namelen = dgram.addrLen;
+                msgs[n].msg_hdr.msg_iov = &iov[n];
+                msgs[n].msg_hdr.msg_iovlen = 1U;
+                n++;
+            }
+
+            // sendmmsg() may stop short of the full batch; resume where it left off
+            uint32_t sent = 0U;
+            while (sent < n) {
+                int ret = ::sendmmsg(m_fd[i], msgs + sent, n - sent, 0);
+                if (ret < 0 && errno == EINTR)
+                    continue;
+
+                if (ret <= 0) {
+                    LogError(LOG_NET, "Error returned from sendmmsg, err: %d", errno);
+                    break;
+                }
+
+                for (int j = 0; j < ret; j++) {
+                    if (msgs[sent + j].msg_len == iov[sent + j].iov_len)
+                        written++;
+                }
+
+                sent += (uint32_t)ret;
+            }
+        }
+    }
+
+    return written >= count;
+#else
+    bool result = true;
+    for (uint32_t i = 0U; i < count; i++) {
+        if (!write(datagrams[i].buffer, datagrams[i].length, datagrams[i].address, datagrams[i].addrLen))
+            result = false;
+    }
+
+    return result;
+#endif
+}
+
 /// <summary>
 /// Closes the UDP socket connection.
 /// </summary>
@@ -314,6 +474,18 @@ void UDPSocket::close()
         close(i);
 }
 
+/// <summary>
+/// Gets the descriptors of the open sockets.
+/// </summary>
+/// <param name="fds">List the socket descriptors are appended to.</param>
+void UDPSocket::getFds(std::vector<int>& fds) const
+{
+    for (int i = 0; i < UDP_SOCKET_MAX; i++) {
+        if (m_fd[i] >= 0)
+            fds.push_back(m_fd[i]);
+    }
+}
+
 /// <summary>
 /// Closes the UDP socket connection.
 /// </summary>
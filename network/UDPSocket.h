@@ -33,6 +33,7 @@
 #include "Defines.h"
 
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) && !defined(_WIN64)
 #include <netdb.h>
@@ -53,6 +54,10 @@
 #define UDP_SOCKET_MAX	1
 #endif
 
+#if !defined(UDP_BATCH_MAX)
+#define UDP_BATCH_MAX	64
+#endif
+
 enum IPMATCHTYPE {
     IMT_ADDRESS_AND_PORT,
     IMT_ADDRESS_ONLY
@@ -60,6 +65,19 @@ enum IPMATCHTYPE {
 
 namespace network
 {
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    //      Represents a single datagram slot for a batched socket read or write.
+    // ---------------------------------------------------------------------------
+
+    struct UDPDatagram {
+        uint8_t* buffer;            // buffer to receive into
+        uint32_t size;              // size of the buffer
+        uint32_t length;            // length of the datagram
+        sockaddr_storage address;   // address the datagram was received from or is sent to
+        uint32_t addrLen;
+    };
+
     // ---------------------------------------------------------------------------
     //  Class Declaration
     //      This class implements low-level routines to communicate over a UDP
@@ -84,11 +102,17 @@ namespace network
 
         /// <summary>Read data from the UDP socket.</summary>
         int read(uint8_t* buffer, uint32_t length, sockaddr_storage& address, uint32_t& addrLen);
+        /// <summary>Read a batch of datagrams from the UDP socket.</summary>
+        int read(UDPDatagram* datagrams, uint32_t count);
         /// <summary>Write data to the UDP socket.</summary>
         bool write(const uint8_t* buffer, uint32_t length, const sockaddr_storage& address, uint32_t addrLen);
+        /// <summary>Write a batch of datagrams to the UDP socket.</summary>
+        bool write(const UDPDatagram* datagrams, uint32_t count);
 
         /// <summary>Closes the UDP socket connection.</summary>
         void close();
+        /// <summary>Gets the descriptors of the open sockets.</summary>
+        void getFds(std::vector<int>& fds) const;
         /// <summary>Closes the UDP socket connection.</summary>
         void close(const uint32_t index);
 
@@ -41,7 +41,6 @@
 #include "edac/CRC.h"
 #include "HostMain.h"
 #include "Log.h"
-#include "Thread.h"
 #include "Utils.h"
 
 using namespace p25;
@@ -57,6 +56,79 @@ using namespace p25;
 
 const uint32_t TIME_BETWEEN_FRAMES = 60U;
 
+const uint32_t VOICE_JOB_COUNT = 16U;
+
+// room for the 3 DMR bursts of every outstanding voice job, plus the call header and terminator
+const uint32_t DMR_TX_QUEUE_CAPACITY = VOICE_JOB_COUNT * 3U + 8U;
+
+// offsets of the 9 IMBE codewords within a network LDU1/LDU2 frame
+const uint32_t LDU_IMBE_OFFSET[9U] = { 10U, 23U, 41U, 58U, 75U, 92U, 109U, 126U, 142U };
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+//      Represents the vocoder work for a single LDU (9 IMBE codewords to 9 AMBE
+//      codewords), or a marker for the end of the call.
+// ---------------------------------------------------------------------------
+
+class Transcode::VoiceJob : public vocoder::VocoderJob {
+public:
+    /// <summary>Initializes a new instance of the VoiceJob class.</summary>
+    VoiceJob(vocoder::VocoderContext* context) :
+        m_terminator(false),
+        m_newCall(false),
+        m_srcId(0U),
+        m_dstId(0U),
+        m_group(false),
+        m_context(context)
+    {
+        ::memset(m_imbe, 0x00U, sizeof(m_imbe));
+        ::memset(m_ambe, 0x00U, sizeof(m_ambe));
+        ::memset(m_errs, 0x00U, sizeof(m_errs));
+    }
+
+    /// <summary>Prepares a recycled job for the passed call.</summary>
+    void init(const lc::LC& lc)
+    {
+        m_terminator = false;
+        m_newCall = false;
+        m_srcId = lc.getSrcId();
+        m_dstId = lc.getDstId();
+        m_group = lc.getGroup();
+    }
+
+    /// <summary>Transcodes the IMBE codewords into AMBE codewords.</summary>
+    void process()
+    {
+        if (m_terminator) {
+            m_context->finishCall();
+            return;
+        }
+
+        // a new call starts from the initial vocoder state rather than the tail of the last one
+        if (m_newCall) {
+            m_context->reset();
+        }
+
+        for (uint8_t n = 0; n < 9U; n++) {
+            m_errs[n] = m_context->transcode(m_imbe + (n * 11U), m_ambe + (n * 9U));
+        }
+    }
+
+    bool m_terminator;
+    bool m_newCall;
+
+    uint32_t m_srcId;
+    uint32_t m_dstId;
+    bool m_group;
+
+    uint8_t m_imbe[9U * 11U];
+    uint8_t m_ambe[9U * 9U];
+    int32_t m_errs[9U];
+
+private:
+    vocoder::VocoderContext* m_context;
+};
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -65,11 +137,15 @@ const uint32_t TIME_BETWEEN_FRAMES = 60U;
 /// </summary>
 /// <param name="network">Instance of the BaseNetwork class representing the source network.</param>
 /// <param name="network">Instance of the BaseNetwork class representing the destination network.</param>
+/// <param name="vocoderPool">Instance of the VocoderPool class to run vocoder work on.</param>
 /// <param name="timeout">Transmit timeout.</param>
 /// <param name="gainAdjust"></param>
+/// <param name="transcodeMode">Vocoder transcode mode.</param>
+/// <param name="compare">Flag indicating whether the vocoder A/B comparison is enabled.</param>
+/// <param name="floatFFT">Flag indicating whether speech analysis uses the float FFT.</param>
 /// <param name="debug">Flag indicating whether P25 debug is enabled.</param>
 /// <param name="verbose">Flag indicating whether P25 verbose logging is enabled.</param>
-Transcode::Transcode(network::BaseNetwork* srcNetwork, network::BaseNetwork* dstNetwork, uint32_t timeout, float gainAdjust, bool debug, bool verbose) :
+Transcode::Transcode(network::BaseNetwork* srcNetwork, network::BaseNetwork* dstNetwork, vocoder::VocoderPool* vocoderPool, uint32_t timeout, float gainAdjust, vocoder::TRANSCODE_MODE transcodeMode, bool compare, bool floatFFT, bool debug, bool verbose) :
     m_srcNetwork(srcNetwork),
     m_dstNetwork(dstNetwork),
     m_netState(RS_NET_IDLE),
@@ -78,37 +154,42 @@ Transcode::Transcode(network::BaseNetwork* srcNetwork, network::BaseNetwork* dst
     m_netFrames(0U),
     m_netLost(0U),
     m_netLC(),
-    m_netLDU1(nullptr),
-    m_netLDU2(nullptr),
+    m_netLDU1(),
+    m_netLDU2(),
     m_lastIMBE(nullptr),
     m_ambeBuffer(nullptr),
     m_ambeCount(0U),
     m_dmrSeqNo(0U),
     m_dmrN(0U),
     m_embeddedData(),
-    m_mbeDecode(nullptr),
-    m_mbeEncode(nullptr),
+    m_dmrTxQueue(dstNetwork, TIME_BETWEEN_FRAMES, DMR_TX_QUEUE_CAPACITY),
+    m_vocoderContext(nullptr),
+    m_vocoder(nullptr),
+    m_voiceJobs(nullptr),
+    m_voiceJobNext(0U),
+    m_voiceJobsInUse(0U),
+    m_newCallPending(false),
     m_verbose(verbose),
     m_debug(debug)
 {
     assert(srcNetwork != nullptr);
     assert(dstNetwork != nullptr);
 
-    m_netLDU1 = new uint8_t[9U * 25U];
-    m_netLDU2 = new uint8_t[9U * 25U];
-
-    ::memset(m_netLDU1, 0x00U, 9U * 25U);
-    ::memset(m_netLDU2, 0x00U, 9U * 25U);
-
     m_lastIMBE = new uint8_t[11U];
     ::memcpy(m_lastIMBE, P25_NULL_IMBE, 11U);
 
     m_ambeBuffer = new uint8_t[dmr::DMR_AMBE_LENGTH_BYTES];
     ::memset(m_ambeBuffer, 0x00U, dmr::DMR_AMBE_LENGTH_BYTES);
 
-    m_mbeDecode = new vocoder::MBEDecoder(vocoder::DECODE_88BIT_IMBE);
-    m_mbeEncode = new vocoder::MBEEncoder(vocoder::ENCODE_DMR_AMBE);
-    m_mbeEncode->setGainAdjust(gainAdjust);
+    m_vocoderContext = new vocoder::VocoderContext(vocoder::DECODE_88BIT_IMBE, vocoder::ENCODE_DMR_AMBE, gainAdjust, transcodeMode, compare, floatFFT);
+
+    m_vocoder = new vocoder::VocoderChannel(vocoderPool);
+
+    // voice jobs are recycled through a fixed ring so the voice path never allocates
+    m_voiceJobs = new VoiceJob*[VOICE_JOB_COUNT];
+    for (uint32_t i = 0U; i < VOICE_JOB_COUNT; i++) {
+        m_voiceJobs[i] = new VoiceJob(m_vocoderContext);
+    }
 }
 
 /// <summary>
@@ -116,12 +197,16 @@ Transcode::Transcode(network::BaseNetwork* srcNetwork, network::BaseNetwork* dst
 /// </summary>
 Transcode::~Transcode()
 {
-    delete[] m_netLDU1;
-    delete[] m_netLDU2;
     delete[] m_lastIMBE;
     delete m_ambeBuffer;
-    delete m_mbeDecode;
-    delete m_mbeEncode;
+    delete m_vocoder;
+
+    for (uint32_t i = 0U; i < VOICE_JOB_COUNT; i++) {
+        delete m_voiceJobs[i];
+    }
+
+    delete[] m_voiceJobs;
+    delete m_vocoderContext;
 }
 
 /// <summary>
@@ -131,7 +216,10 @@ Transcode::~Transcode()
 void Transcode::clock(uint32_t ms)
 {
     if (m_srcNetwork != nullptr) {
-        processNetwork();
+        // consume every frame queued by the network
+        while (m_srcNetwork->hasP25Data()) {
+            processNetwork();
+        }
     }
 
     m_netTimeout.clock(ms);
@@ -144,7 +232,7 @@ void Transcode::clock(uint32_t ms)
                 ::LogInfoEx(LOG_P25, "network watchdog has expired, %.1f seconds, %u%% packet loss",
                     float(m_netFrames) / 50.0F, (m_netLost * 100U) / m_netFrames);
 
-                writeNet_DMR_Terminator();
+                queueNet_DMR_Terminator();
             }
             else {
                 ::LogInfoEx(LOG_P25, "network watchdog has expired");
@@ -156,6 +244,49 @@ void Transcode::clock(uint32_t ms)
             m_netTimeout.stop();
         }
     }
+
+    // build DMR frames for any completed vocoder work
+    vocoder::VocoderJob* job = nullptr;
+    while ((job = m_vocoder->getCompleted()) != nullptr) {
+        VoiceJob* voice = static_cast<VoiceJob*>(job);
+        if (voice->m_terminator) {
+            writeNet_DMR_Terminator(*voice);
+        }
+        else {
+            writeNet_DMR_Voice(*voice);
+        }
+
+        m_voiceJobsInUse--;
+    }
+
+    // write out any DMR frames that are due
+    m_dmrTxQueue.clock(ms);
+}
+
+/// <summary>
+/// Gets the number of milliseconds until the next timer or queued frame is due.
+/// </summary>
+/// <remarks>Frames that are already due are reported by hasTxData() instead.</remarks>
+/// <returns>Milliseconds until the next deadline, or zero if nothing is pending.</returns>
+uint32_t Transcode::getNextDeadline()
+{
+    uint32_t deadline = 0U;
+    m_dmrTxQueue.getNextDeadline(deadline);
+    if (m_netState == RS_NET_AUDIO) {
+        deadline = Timer::earliest(deadline, m_networkWatchdog.getRemainingMs());
+    }
+
+    return deadline;
+}
+
+/// <summary>
+/// Helper to return whether queued DMR frames are already due to be written.
+/// </summary>
+/// <returns>True, if a queued frame is due, otherwise false.</returns>
+bool Transcode::hasTxData() const
+{
+    uint32_t deadline = 0U;
+    return m_dmrTxQueue.getNextDeadline(deadline) && deadline == 0U;
 }
 
 // ---------------------------------------------------------------------------
@@ -170,26 +301,28 @@ void Transcode::processNetwork()
     data::LowSpeedData lsd;
     uint8_t duid;
 
-    uint32_t length = 100U;
-    bool ret = false;
-    uint8_t* data = m_srcNetwork->readP25(ret, control, lsd, duid, length);
+    // the frame buffer goes back to the network packet pool when this returns, unless
+    // it is held as the pending LDU1/LDU2
+    network::PacketView frame;
+    bool ret = m_srcNetwork->readP25(frame, control, lsd, duid);
     if (!ret)
         return;
-    if (length == 0U)
-        return;
-    if (data == nullptr) {
+    if (!frame.isValid()) {
         m_srcNetwork->resetP25();
         return;
     }
 
+    uint8_t* data = frame.get();
+    uint32_t length = frame.getLength();
+    if (length == 0U)
+        return;
+
     m_networkWatchdog.start();
 
     if (m_debug) {
         Utils::dump(2U, "!!! *P25 Network Frame", data, length);
     }
 
-    uint32_t count = 0U;
-
     switch (duid) {
     case P25_DUID_LDU1:
         // The '62', '63', '64', '65', '66', '67', '68', '69', '6A' records are LDU1
@@ -198,41 +331,9 @@ void Transcode::processNetwork()
             (data[70U] == 0x66U) && (data[87U] == 0x67U) &&
             (data[104U] == 0x68U) && (data[121U] == 0x69U) &&
             (data[138U] == 0x6AU)) {
-            // The '62' record - IMBE Voice 1
-            ::memcpy(m_netLDU1 + 0U, data + count, 22U);
-            count += 22U;
-
-            // The '63' record - IMBE Voice 2
-            ::memcpy(m_netLDU1 + 25U, data + count, 14U);
-            count += 14U;
-
-            // The '64' record - IMBE Voice 3 + Link Control
-            ::memcpy(m_netLDU1 + 50U, data + count, 17U);
-            count += 17U;
-
-            // The '65' record - IMBE Voice 4 + Link Control
-            ::memcpy(m_netLDU1 + 75U, data + count, 17U);
-            count += 17U;
-
-            // The '66' record - IMBE Voice 5 + Link Control
-            ::memcpy(m_netLDU1 + 100U, data + count, 17U);
-            count += 17U;
-
-            // The '67' record - IMBE Voice 6 + Link Control
-            ::memcpy(m_netLDU1 + 125U, data + count, 17U);
-            count += 17U;
-
-            // The '68' record - IMBE Voice 7 + Link Control
-            ::memcpy(m_netLDU1 + 150U, data + count, 17U);
-            count += 17U;
-
-            // The '69' record - IMBE Voice 8 + Link Control
-            ::memcpy(m_netLDU1 + 175U, data + count, 17U);
-            count += 17U;
-
-            // The '6A' record - IMBE Voice 9 + Low Speed Data
-            ::memcpy(m_netLDU1 + 200U, data + count, 16U);
-            count += 16U;
+            // The '62' - '6A' records carry IMBE Voice 1 - 9, Link Control and Low Speed Data;
+            // hold on to the frame itself rather than copying it
+            m_netLDU1.swap(frame);
 
             checkNet_LDU2(control, lsd);
             if (m_netState != RS_NET_IDLE) {
@@ -247,41 +348,9 @@ void Transcode::processNetwork()
             (data[70U] == 0x6FU) && (data[87U] == 0x70U) &&
             (data[104U] == 0x71U) && (data[121U] == 0x72U) &&
             (data[138U] == 0x73U)) {
-            // The '6B' record - IMBE Voice 10
-            ::memcpy(m_netLDU2 + 0U, data + count, 22U);
-            count += 22U;
-
-            // The '6C' record - IMBE Voice 11
-            ::memcpy(m_netLDU2 + 25U, data + count, 14U);
-            count += 14U;
-
-            // The '6D' record - IMBE Voice 12 + Encryption Sync
-            ::memcpy(m_netLDU2 + 50U, data + count, 17U);
-            count += 17U;
-
-            // The '6E' record - IMBE Voice 13 + Encryption Sync
-            ::memcpy(m_netLDU2 + 75U, data + count, 17U);
-            count += 17U;
-
-            // The '6F' record - IMBE Voice 14 + Encryption Sync
-            ::memcpy(m_netLDU2 + 100U, data + count, 17U);
-            count += 17U;
-
-            // The '70' record - IMBE Voice 15 + Encryption Sync
-            ::memcpy(m_netLDU2 + 125U, data + count, 17U);
-            count += 17U;
-
-            // The '71' record - IMBE Voice 16 + Encryption Sync
-            ::memcpy(m_netLDU2 + 150U, data + count, 17U);
-            count += 17U;
-
-            // The '72' record - IMBE Voice 17 + Encryption Sync
-            ::memcpy(m_netLDU2 + 175U, data + count, 17U);
-            count += 17U;
-
-            // The '73' record - IMBE Voice 18 + Low Speed Data
-            ::memcpy(m_netLDU2 + 200U, data + count, 16U);
-            count += 16U;
+            // The '6B' - '73' records carry IMBE Voice 10 - 18, Encryption Sync and Low Speed Data;
+            // hold on to the frame itself rather than copying it
+            m_netLDU2.swap(frame);
 
             if (m_netState == RS_NET_IDLE) {
                 writeNet_LDU1(control, lsd);
@@ -298,7 +367,7 @@ void Transcode::processNetwork()
     case P25_DUID_TDU:
     case P25_DUID_TDULC:
         if (m_netState != RS_NET_IDLE) {
-            writeNet_DMR_Terminator();
+            queueNet_DMR_Terminator();
 
             m_netState = RS_NET_IDLE;
 
@@ -312,21 +381,20 @@ void Transcode::processNetwork()
     case P25_DUID_TSDU:
         break;
     }
-
-    delete data;
 }
 
 /// <summary>
 ///
 /// </summary>
-void Transcode::writeNet_DMR_Terminator()
+/// <param name="job"></param>
+void Transcode::writeNet_DMR_Terminator(const VoiceJob& job)
 {
     // send DMR voice header
     dmr::data::Data dmrData;
-    dmrData.setSrcId(m_netLC.getSrcId());
-    dmrData.setDstId(m_netLC.getDstId());
+    dmrData.setSrcId(job.m_srcId);
+    dmrData.setDstId(job.m_dstId);
 
-    if (m_netLC.getGroup()) {
+    if (job.m_group) {
         dmrData.setFLCO(dmr::FLCO_GROUP);
     }
     else {
@@ -362,12 +430,10 @@ void Transcode::writeNet_DMR_Terminator()
 
             dmrData.setData(data);
 
-            m_dstNetwork->writeDMR(dmrData);
+            m_dmrTxQueue.enqueue(dmrData);
 
             n++;
             m_dmrSeqNo++;
-
-            Thread::sleep(TIME_BETWEEN_FRAMES);
         }
     }
 
@@ -392,12 +458,12 @@ void Transcode::writeNet_DMR_Terminator()
     dmr::Sync::addDMRDataSync(data, true); // hardcoded to duplex?
 
     if (m_verbose) {
-        LogMessage(LOG_P25, DMR_DT_TERMINATOR_WITH_LC ", dstId = %u", m_netLC.getDstId());
+        LogMessage(LOG_P25, DMR_DT_TERMINATOR_WITH_LC ", dstId = %u", job.m_dstId);
     }
 
     dmrData.setData(data);
 
-    m_dstNetwork->writeDMR(dmrData);
+    m_dmrTxQueue.enqueue(dmrData);
 
     m_ambeCount = 0U;
     m_dmrSeqNo = 0U;
@@ -407,12 +473,31 @@ void Transcode::writeNet_DMR_Terminator()
 /// <summary>
 ///
 /// </summary>
-/// <param name="ldu"></param>
-void Transcode::decodeAndProcessIMBE(uint8_t* ldu)
+/// <param name="job">Voice job holding the LDU IMBE codewords, or nullptr if the LDU was dropped.</param>
+void Transcode::decodeAndProcessIMBE(VoiceJob* job)
 {
     if (m_netState == RS_NET_IDLE) {
         m_netState = RS_NET_AUDIO;
+        m_newCallPending = true;
+    }
+
+    // if the vocoder overran, the start of the call carries over to the next LDU that gets a job
+    if (job == nullptr)
+        return;
 
+    job->m_newCall = m_newCallPending;
+    m_newCallPending = false;
+
+    m_vocoder->submit(job);
+}
+
+/// <summary>
+/// Helper to write DMR voice frames for a completed vocoder job.
+/// </summary>
+/// <param name="job"></param>
+void Transcode::writeNet_DMR_Voice(const VoiceJob& job)
+{
+    if (job.m_newCall) {
         m_ambeCount = 0U;
         m_dmrSeqNo = 0U;
     }
@@ -424,11 +509,11 @@ void Transcode::decodeAndProcessIMBE(uint8_t* ldu)
             if (m_dmrSeqNo == 0U) {
                 // send DMR voice header
                 dmr::data::Data dmrData;
-                dmrData.setSrcId(m_netLC.getSrcId());
-                dmrData.setDstId(m_netLC.getDstId());
+                dmrData.setSrcId(job.m_srcId);
+                dmrData.setDstId(job.m_dstId);
                 dmrData.setSeqNo(m_dmrSeqNo);
 
-                if (m_netLC.getGroup()) {
+                if (job.m_group) {
                     dmrData.setFLCO(dmr::FLCO_GROUP);
                 }
                 else {
@@ -465,21 +550,19 @@ void Transcode::decodeAndProcessIMBE(uint8_t* ldu)
 
                 dmrData.setData(data);
 
-                m_dstNetwork->writeDMR(dmrData);
+                m_dmrTxQueue.enqueue(dmrData);
 
                 m_dmrSeqNo++;
-
-                Thread::sleep(TIME_BETWEEN_FRAMES);
             }
 
             // send DMR voice
             dmr::data::Data dmrData;
-            dmrData.setSrcId(m_netLC.getSrcId());
-            dmrData.setDstId(m_netLC.getDstId());
+            dmrData.setSrcId(job.m_srcId);
+            dmrData.setDstId(job.m_dstId);
             dmrData.setSeqNo(m_dmrSeqNo);
             dmrData.setN(m_dmrN);
 
-            if (m_netLC.getGroup()) {
+            if (job.m_group) {
                 dmrData.setFLCO(dmr::FLCO_GROUP);
             }
             else {
@@ -531,71 +614,42 @@ void Transcode::decodeAndProcessIMBE(uint8_t* ldu)
 
             dmrData.setData(data);
 
-            m_dstNetwork->writeDMR(dmrData);
+            m_dmrTxQueue.enqueue(dmrData);
             m_dmrSeqNo++;
 
-            Thread::sleep(TIME_BETWEEN_FRAMES);
-
             // clear AMBE buffer
             ::memset(m_ambeBuffer, 0x00U, dmr::DMR_AMBE_LENGTH_BYTES);
             m_ambeCount = 0U;
         }
 
-        // get P25 IMBE codeword
-        uint8_t imbe[11U];
-        ::memset(imbe, 0x00U, 11U);
-
-        switch (n) {
-        case 0:
-            ::memcpy(imbe, ldu + 10U, 11U);
-            break;
-        case 1:
-            ::memcpy(imbe, ldu + 26U, 11U);
-            break;
-        case 2:
-            ::memcpy(imbe, ldu + 55U, 11U);
-            break;
-        case 3:
-            ::memcpy(imbe, ldu + 80U, 11U);
-            break;
-        case 4:
-            ::memcpy(imbe, ldu + 105U, 11U);
-            break;
-        case 5:
-            ::memcpy(imbe, ldu + 130U, 11U);
-            break;
-        case 6:
-            ::memcpy(imbe, ldu + 155U, 11U);
-            break;
-        case 7:
-            ::memcpy(imbe, ldu + 180U, 11U);
-            break;
-        case 8:
-            ::memcpy(imbe, ldu + 204U, 11U);
-            break;
+        if (m_debug) {
+            LogDebug(LOG_P25, "decoded IMBE VC%u, errs = %u", n, job.m_errs[n]);
+            Utils::dump(1U, "DMR AMBE", job.m_ambe + (n * 9U), 9U);
         }
 
-        // decode IMBE into PCM
-        int16_t pcmSamples[160U];
-        ::memset(pcmSamples, 0x00U, 160U);
+        ::memcpy(m_ambeBuffer + (m_ambeCount * 9U), job.m_ambe + (n * 9U), 9U);
+        m_ambeCount++;
+    }
+}
 
-        int32_t errs = m_mbeDecode->decode(imbe, pcmSamples);
-        if (m_debug) {
-            LogDebug(LOG_P25, "decoded IMBE VC%u, errs = %u", n, errs);
-        }
+/// <summary>
+/// Helper to queue a DMR terminator behind any outstanding vocoder jobs.
+/// </summary>
+void Transcode::queueNet_DMR_Terminator()
+{
+    // a call whose audio never reached the vocoder put nothing on air to terminate
+    if (m_newCallPending) {
+        m_newCallPending = false;
+        return;
+    }
 
-        // encode PCM into AMBE
-        uint8_t ambe[9U];
-        ::memset(ambe, 0x00U, 9U);
+    VoiceJob* job = acquireVoiceJob(true);
+    if (job == nullptr)
+        return;
 
-        m_mbeEncode->encode(pcmSamples, ambe);
-        if (m_debug) {
-            Utils::dump(1U, "DMR AMBE", ambe, 9U);
-        }
+    job->m_terminator = true;
 
-        ::memcpy(m_ambeBuffer + (m_ambeCount * 9U), ambe, 9U);
-        m_ambeCount++;
-    }
+    m_vocoder->submit(job);
 }
 
 /// <summary>
@@ -609,9 +663,7 @@ void Transcode::checkNet_LDU1(const lc::LC& control, const data::LowSpeedData& l
         return;
 
     // Check for an unflushed LDU1
-    if (m_netLDU1[0U] != 0x00U || m_netLDU1[25U] != 0x00U || m_netLDU1[50U] != 0x00U ||
-        m_netLDU1[75U] != 0x00U || m_netLDU1[100U] != 0x00U || m_netLDU1[125U] != 0x00U ||
-        m_netLDU1[150U] != 0x00U || m_netLDU1[175U] != 0x00U || m_netLDU1[200U] != 0x00U)
+    if (m_netLDU1.isValid())
         writeNet_LDU1(control, lsd);
 }
 
@@ -628,7 +680,11 @@ void Transcode::writeNet_LDU1(const lc::LC& control, const data::LowSpeedData& l
     uint32_t srcId = control.getSrcId();
     bool group = control.getLCO() == LC_GROUP;
 
-    uint8_t serviceOptions = (uint8_t)(m_netLDU1[53U]);
+    // service options follow the '64' record LCO, MFId
+    uint8_t serviceOptions = 0x00U;
+    if (m_netLDU1.isValid()) {
+        serviceOptions = m_netLDU1.get()[39U];
+    }
 
     m_netLC.reset();
     m_netLC.setLCO(lco);
@@ -644,7 +700,9 @@ void Transcode::writeNet_LDU1(const lc::LC& control, const data::LowSpeedData& l
     m_netFrames = 0U;
     m_netLost = 0U;
 
-    insertMissingAudio(m_netLDU1);
+    // the codewords are unpacked from the frame straight into the voice job
+    VoiceJob* job = acquireVoiceJob();
+    insertMissingAudio(m_netLDU1, (job != nullptr) ? job->m_imbe : nullptr);
 
     if (m_verbose) {
         uint32_t loss = 0;
@@ -663,9 +721,9 @@ void Transcode::writeNet_LDU1(const lc::LC& control, const data::LowSpeedData& l
     }
 
     // Process the audio
-    decodeAndProcessIMBE(m_netLDU1);
+    decodeAndProcessIMBE(job);
 
-    ::memset(m_netLDU1, 0x00U, 9U * 25U);
+    m_netLDU1.release();
 
     m_netFrames += 9U;
 }
@@ -681,9 +739,7 @@ void Transcode::checkNet_LDU2(const lc::LC& control, const data::LowSpeedData& l
         return;
 
     // Check for an unflushed LDU2
-    if (m_netLDU2[0U] != 0x00U || m_netLDU2[25U] != 0x00U || m_netLDU2[50U] != 0x00U ||
-        m_netLDU2[75U] != 0x00U || m_netLDU2[100U] != 0x00U || m_netLDU2[125U] != 0x00U ||
-        m_netLDU2[150U] != 0x00U || m_netLDU2[175U] != 0x00U || m_netLDU2[200U] != 0x00U)
+    if (m_netLDU2.isValid())
         writeNet_LDU2(control, lsd);
 }
 
@@ -694,13 +750,16 @@ void Transcode::checkNet_LDU2(const lc::LC& control, const data::LowSpeedData& l
 /// <param name="lsd"></param>
 void Transcode::writeNet_LDU2(const lc::LC& control, const data::LowSpeedData& lsd)
 {
-    uint8_t algId = m_netLDU2[126U];
-    uint32_t kId = (m_netLDU2[127U] << 8) + m_netLDU2[128U];
+    assert(m_netLDU2.isValid());
+    const uint8_t* ldu = m_netLDU2.get();
+
+    uint8_t algId = ldu[88U];
+    uint32_t kId = (ldu[89U] << 8) + ldu[90U];
 
     uint8_t mi[P25_MI_LENGTH_BYTES];
-    ::memcpy(mi + 0U, m_netLDU2 + 51U, 3U);
-    ::memcpy(mi + 3U, m_netLDU2 + 76U, 3U);
-    ::memcpy(mi + 6U, m_netLDU2 + 101U, 3U);
+    ::memcpy(mi + 0U, ldu + 37U, 3U);
+    ::memcpy(mi + 3U, ldu + 54U, 3U);
+    ::memcpy(mi + 6U, ldu + 71U, 3U);
 
     // Utils::dump(1U, "LDU2 Network MI", mi, P25_MI_LENGTH_BYTES);
 
@@ -708,7 +767,9 @@ void Transcode::writeNet_LDU2(const lc::LC& control, const data::LowSpeedData& l
     m_netLC.setAlgId(algId);
     m_netLC.setKId(kId);
 
-    insertMissingAudio(m_netLDU2);
+    // the codewords are unpacked from the frame straight into the voice job
+    VoiceJob* job = acquireVoiceJob();
+    insertMissingAudio(m_netLDU2, (job != nullptr) ? job->m_imbe : nullptr);
 
     if (m_verbose) {
         uint32_t loss = 0;
@@ -726,88 +787,60 @@ void Transcode::writeNet_LDU2(const lc::LC& control, const data::LowSpeedData& l
     }
 
     // Process the audio
-    decodeAndProcessIMBE(m_netLDU2);
+    decodeAndProcessIMBE(job);
 
-    ::memset(m_netLDU2, 0x00U, 9U * 25U);
+    m_netLDU2.release();
 
     m_netFrames += 9U;
 }
 
 /// <summary>
-/// Helper to insert IMBE silence frames for missing audio.
+/// Helper to take the next free voice job from the voice job ring.
 /// </summary>
-/// <param name="data"></param>
-void Transcode::insertMissingAudio(uint8_t* data)
+/// <param name="terminator">Flag indicating the job ends the call and may take the job kept back for it.</param>
+/// <returns>Voice job prepared for the current call, or nullptr if every job is still with the vocoder.</returns>
+Transcode::VoiceJob* Transcode::acquireVoiceJob(bool terminator)
 {
-    if (data[0U] == 0x00U) {
-        ::memcpy(data + 10U, m_lastIMBE, 11U);
-        m_netLost++;
-    }
-    else {
-        ::memcpy(m_lastIMBE, data + 10U, 11U);
-    }
-
-    if (data[25U] == 0x00U) {
-        ::memcpy(data + 26U, m_lastIMBE, 11U);
-        m_netLost++;
-    }
-    else {
-        ::memcpy(m_lastIMBE, data + 26U, 11U);
-    }
-
-    if (data[50U] == 0x00U) {
-        ::memcpy(data + 55U, m_lastIMBE, 11U);
-        m_netLost++;
-    }
-    else {
-        ::memcpy(m_lastIMBE, data + 55U, 11U);
-    }
-
-    if (data[75U] == 0x00U) {
-        ::memcpy(data + 80U, m_lastIMBE, 11U);
-        m_netLost++;
-    }
-    else {
-        ::memcpy(m_lastIMBE, data + 80U, 11U);
-    }
+    // jobs come back from the vocoder in submission order, so the ring only has to
+    // track how many are outstanding; audio always leaves the last job free, so once a
+    // call has audio in the vocoder its terminator is guaranteed a job behind it
+    uint32_t available = terminator ? VOICE_JOB_COUNT : VOICE_JOB_COUNT - 1U;
+    if (m_voiceJobsInUse >= available) {
+        if (terminator) {
+            LogError(LOG_P25, "vocoder overrun, %u voice jobs outstanding, dropping terminator", m_voiceJobsInUse);
+        }
+        else {
+            LogWarning(LOG_P25, "vocoder overrun, %u voice jobs outstanding, dropping audio", m_voiceJobsInUse);
+        }
 
-    if (data[100U] == 0x00U) {
-        ::memcpy(data + 105U, m_lastIMBE, 11U);
-        m_netLost++;
-    }
-    else {
-        ::memcpy(m_lastIMBE, data + 105U, 11U);
+        return nullptr;
     }
 
-    if (data[125U] == 0x00U) {
-        ::memcpy(data + 130U, m_lastIMBE, 11U);
-        m_netLost++;
-    }
-    else {
-        ::memcpy(m_lastIMBE, data + 130U, 11U);
-    }
+    VoiceJob* job = m_voiceJobs[m_voiceJobNext];
+    m_voiceJobNext = (m_voiceJobNext + 1U) % VOICE_JOB_COUNT;
+    m_voiceJobsInUse++;
 
-    if (data[150U] == 0x00U) {
-        ::memcpy(data + 155U, m_lastIMBE, 11U);
-        m_netLost++;
-    }
-    else {
-        ::memcpy(m_lastIMBE, data + 155U, 11U);
-    }
+    job->init(m_netLC);
+    return job;
+}
 
-    if (data[175U] == 0x00U) {
-        ::memcpy(data + 180U, m_lastIMBE, 11U);
-        m_netLost++;
-    }
-    else {
-        ::memcpy(m_lastIMBE, data + 180U, 11U);
-    }
+/// <summary>
+/// Helper to insert IMBE silence frames for missing audio.
+/// </summary>
+/// <param name="ldu">Network LDU frame, or an invalid view if the LDU was not received.</param>
+/// <param name="imbe">Buffer that receives the 9 IMBE codewords, or nullptr to only track the audio.</param>
+void Transcode::insertMissingAudio(const network::PacketView& ldu, uint8_t* imbe)
+{
+    for (uint8_t n = 0U; n < 9U; n++) {
+        if (!ldu.isValid()) {
+            m_netLost++;
+        }
+        else {
+            ::memcpy(m_lastIMBE, ldu.get() + LDU_IMBE_OFFSET[n], 11U);
+        }
 
-    if (data[200U] == 0x00U) {
-        ::memcpy(data + 204U, m_lastIMBE, 11U);
-        m_netLost++;
-    }
-    else {
-        ::memcpy(m_lastIMBE, data + 204U, 11U);
+        if (imbe != nullptr) {
+            ::memcpy(imbe + (n * 11U), m_lastIMBE, 11U);
+        }
     }
 }
@@ -33,9 +33,10 @@
 
 #include "Defines.h"
 #include "dmr/data/EmbeddedData.h"
+#include "dmr/TxQueue.h"
 #include "network/BaseNetwork.h"
-#include "vocoder/MBEDecoder.h"
-#include "vocoder/MBEEncoder.h"
+#include "vocoder/VocoderContext.h"
+#include "vocoder/VocoderPool.h"
 #include "RingBuffer.h"
 #include "Timer.h"
 
@@ -51,14 +52,23 @@ namespace p25
     class HOST_SW_API Transcode {
     public:
         /// <summary>Initializes a new instance of the Transcode class.</summary>
-        Transcode(network::BaseNetwork* srcNetwork, network::BaseNetwork* dstNetwork, uint32_t timeout, float gainAdjust, bool debug, bool verbose);
+        Transcode(network::BaseNetwork* srcNetwork, network::BaseNetwork* dstNetwork, vocoder::VocoderPool* vocoderPool, uint32_t timeout, float gainAdjust, vocoder::TRANSCODE_MODE transcodeMode, bool compare, bool floatFFT, bool debug, bool verbose);
         /// <summary>Finalizes a instance of the Transcode class.</summary>
         ~Transcode();
 
         /// <summary>Updates the processor by the passed number of milliseconds.</summary>
         void clock(uint32_t ms);
 
+        /// <summary>Gets the number of milliseconds until the next timer or queued frame is due.</summary>
+        uint32_t getNextDeadline();
+        /// <summary>Helper to return whether network frames are waiting to be processed.</summary>
+        bool hasRxData() const { return m_srcNetwork->hasP25Data(); }
+        /// <summary>Helper to return whether queued DMR frames are already due to be written.</summary>
+        bool hasTxData() const;
+
     private:
+        class VoiceJob;
+
         network::BaseNetwork* m_srcNetwork;
         network::BaseNetwork* m_dstNetwork;
 
@@ -72,8 +82,8 @@ namespace p25
 
         lc::LC m_netLC;
 
-        uint8_t* m_netLDU1;
-        uint8_t* m_netLDU2;
+        network::PacketView m_netLDU1;
+        network::PacketView m_netLDU2;
         uint8_t* m_lastIMBE;
 
         uint8_t* m_ambeBuffer;
@@ -81,9 +91,15 @@ namespace p25
         uint8_t m_dmrSeqNo;
         uint8_t m_dmrN;
         dmr::data::EmbeddedData m_embeddedData;
+        dmr::TxQueue m_dmrTxQueue;
+
+        vocoder::VocoderContext* m_vocoderContext;
+        vocoder::VocoderChannel* m_vocoder;
 
-        vocoder::MBEDecoder* m_mbeDecode;
-        vocoder::MBEEncoder* m_mbeEncode;
+        VoiceJob** m_voiceJobs;
+        uint32_t m_voiceJobNext;
+        uint32_t m_voiceJobsInUse;
+        bool m_newCallPending;
 
         bool m_verbose;
         bool m_debug;
@@ -91,9 +107,13 @@ namespace p25
         /// <summary>Process a data frames from the network.</summary>
         void processNetwork();
         /// <summary></summary>
-        void writeNet_DMR_Terminator();
+        void writeNet_DMR_Terminator(const VoiceJob& job);
         /// <summary></summary>
-        void decodeAndProcessIMBE(uint8_t* imbe);
+        void decodeAndProcessIMBE(VoiceJob* job);
+        /// <summary>Helper to write DMR voice frames for a completed vocoder job.</summary>
+        void writeNet_DMR_Voice(const VoiceJob& job);
+        /// <summary>Helper to queue a DMR terminator behind any outstanding vocoder jobs.</summary>
+        void queueNet_DMR_Terminator();
 
         /// <summary>Helper to check for an unflushed LDU1 packet.</summary>
         void checkNet_LDU1(const lc::LC& control, const data::LowSpeedData& lsd);
@@ -104,8 +124,10 @@ namespace p25
         /// <summary>Helper to write a network P25 LDU1 packet.</summary>
         void writeNet_LDU2(const lc::LC& control, const data::LowSpeedData& lsd);
 
+        /// <summary>Helper to take the next free voice job from the voice job ring.</summary>
+        VoiceJob* acquireVoiceJob(bool terminator = false);
         /// <summary>Helper to insert IMBE silence frames for missing audio.</summary>
-        void insertMissingAudio(uint8_t* data);
+        void insertMissingAudio(const network::PacketView& ldu, uint8_t* imbe);
     };
 } // namespace p25
 
@@ -694,31 +694,21 @@ void LC::encodeLDUHamming(uint8_t * data, const uint8_t * raw)
 void LC::decodeHDUGolay(const uint8_t * data, uint8_t * raw)
 {
     // shortened Golay (18,6,8) decode
+    uint32_t g0[36U];
     uint32_t n = 0U;
-    uint32_t m = 0U;
     for (uint32_t i = 0U; i < 36U; i++) {
-        bool golay[18U];
-        for (uint32_t j = 0U; j < 18U; j++) {
-            golay[j] = READ_BIT(data, n);
-            n++;
-        }
-
-        uint32_t g0 = 0U;
-        for (uint32_t j = 0U; j < 18U; j++)
-            g0 = (g0 << 1) | (golay[j] ? 0x01U : 0x00U);
+        g0[i] = 0U;
+        for (uint32_t j = 0U; j < 18U; j++, n++)
+            g0[i] = (g0[i] << 1) | (READ_BIT(data, n) ? 0x01U : 0x00U);
+    }
 
-        uint32_t c0data = 0U;
-        edac::Golay24128::decode24128(g0, c0data);
+    uint32_t c0data[36U];
+    edac::Golay24128::decode24128(c0data, g0, 36U, nullptr);
 
-        for (int j = 5; j >= 0; j--) {
-            golay[j] = (c0data & 0x01U) == 0x01U;
-            c0data >>= 1;
-        }
-
-        for (uint32_t j = 0U; j < 6U; j++) {
-            WRITE_BIT(raw, m, golay[j]);
-            m++;
-        }
+    uint32_t m = 0U;
+    for (uint32_t i = 0U; i < 36U; i++) {
+        for (int j = 5; j >= 0; j--, m++)
+            WRITE_BIT(raw, m, (c0data[i] >> j) & 0x01U);
     }
 }
 
@@ -730,27 +720,20 @@ void LC::decodeHDUGolay(const uint8_t * data, uint8_t * raw)
 void LC::encodeHDUGolay(uint8_t * data, const uint8_t * raw)
 {
     // shortened Golay (18,6,8) encode
-    uint32_t n = 0U;
+    uint32_t c0data[36U];
     uint32_t m = 0U;
     for (uint32_t i = 0U; i < 36U; i++) {
-        bool golay[18U];
-        for (uint32_t j = 0U; j < 6U; j++) {
-            golay[j] = READ_BIT(raw, m);
-            m++;
-        }
+        c0data[i] = 0U;
+        for (uint32_t j = 0U; j < 6U; j++, m++)
+            c0data[i] = (c0data[i] << 1) | (READ_BIT(raw, m) ? 0x01U : 0x00U);
+    }
 
-        uint32_t c0data = 0U;
-        for (uint32_t j = 0U; j < 6U; j++)
-            c0data = (c0data << 1) | (golay[j] ? 0x01U : 0x00U);
-        uint32_t g0 = edac::Golay24128::encode24128(c0data);
-        for (int j = 17; j >= 0; j--) {
-            golay[j] = (g0 & 0x01U) == 0x01U;
-            g0 >>= 1;
-        }
+    uint32_t g0[36U];
+    edac::Golay24128::encode24128(g0, c0data, 36U);
 
-        for (uint32_t j = 0U; j < 18U; j++) {
-            WRITE_BIT(data, n, golay[j]);
-            n++;
-        }
+    uint32_t n = 0U;
+    for (uint32_t i = 0U; i < 36U; i++) {
+        for (int j = 17; j >= 0; j--, n++)
+            WRITE_BIT(data, n, (g0[i] >> j) & 0x01U);
     }
 }
@@ -0,0 +1,140 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+//
+//  Regression test for the DMR AMBE bytes built by MBEEncoder. A synthetic
+//  speech-like signal is encoded; every frame must come back out of the DMR
+//  AMBE FEC without errors, and the packed bytes of the whole run must match
+//  a recorded digest. Built with AddressSanitizer where available, so reading
+//  past the 49 AMBE bits while packing them fails the test outright.
+//
+#include "Defines.h"
+#include "vocoder/MBEDecoder.h"
+#include "vocoder/MBEEncoder.h"
+
+using namespace vocoder;
+
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint8_t   BIT_MASK_TABLE[] = { 0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U };
+
+const uint8_t   TAG_DATA = 0x01U;
+
+const uint32_t  FRAME_COUNT = 250U;
+const uint32_t  FRAME_SAMPLES = 160U;
+const uint32_t  AMBE_LENGTH_BYTES = 9U;
+
+// FNV-1a digest of the DMR AMBE bytes for all FRAME_COUNT frames
+const uint32_t  AMBE_DIGEST = 0xF37B033CU;
+
+// ---------------------------------------------------------------------------
+//  Global Variables
+// ---------------------------------------------------------------------------
+
+static uint32_t m_seed = 0x2545F491U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>Returns the next value from a fixed seed xorshift generator.</summary>
+/// <returns></returns>
+static uint32_t nextRandom()
+{
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+    return m_seed;
+}
+
+/// <summary>Fills a frame with a voiced, noisy or silent test signal, depending on where it falls in the run.</summary>
+/// <param name="n">Frame number.</param>
+/// <param name="phase">Running fundamental phase.</param>
+/// <param name="samples"></param>
+static void synthesizeFrame(uint32_t n, float* phase, int16_t* samples)
+{
+    uint32_t section = (n / 25U) % 5U;
+    float pitch = 90.0f + 2.0f * (float)(n % 80U);
+
+    for (uint32_t i = 0U; i < FRAME_SAMPLES; i++) {
+        float s = 0.0f;
+        if (section != 4U) {
+            *phase += 2.0f * (float)M_PI * pitch / 8000.0f;
+            if (*phase > 2.0f * (float)M_PI)
+                *phase -= 2.0f * (float)M_PI;
+
+            for (uint32_t h = 1U; h <= 12U; h++)
+                s += ::sinf(*phase * (float)h) / (float)h;
+            s *= 4000.0f;
+        }
+
+        if (section == 2U || section == 3U)
+            s += (float)((int32_t)(nextRandom() % 4001U) - 2000);
+
+        samples[i] = (int16_t)s;
+    }
+}
+
+/// <summary>Application entry point.</summary>
+/// <returns>Zero if every frame decoded cleanly and the digest matched, otherwise one.</returns>
+int main()
+{
+    MBEEncoder encoder(ENCODE_DMR_AMBE);
+    MBEDecoder decoder(DECODE_DMR_AMBE);
+
+    uint32_t digest = 0x811C9DC5U;
+    uint32_t failures = 0U;
+    float phase = 0.0f;
+
+    for (uint32_t n = 0U; n < FRAME_COUNT; n++) {
+        int16_t samples[FRAME_SAMPLES];
+        synthesizeFrame(n, &phase, samples);
+
+        uint8_t codeword[AMBE_LENGTH_BYTES];
+        ::memset(codeword, 0x00U, AMBE_LENGTH_BYTES);
+        encoder.encode(samples, codeword);
+
+        for (uint32_t i = 0U; i < AMBE_LENGTH_BYTES; i++) {
+            digest ^= codeword[i];
+            digest *= 0x01000193U;
+        }
+
+        mbe_parms parms;
+        int32_t errs = decoder.decodeParms(codeword, &parms);
+        if (errs != 0) {
+            ::fprintf(stdout, "frame %u: %d FEC errors in encoded DMR AMBE\n", n, errs);
+            failures++;
+        }
+    }
+
+    ::fprintf(stdout, "%u frames, digest %08X (expected %08X), %u FEC failures\n", FRAME_COUNT, digest, AMBE_DIGEST, failures);
+    return (failures == 0U && digest == AMBE_DIGEST) ? 0 : 1;
+}
@@ -0,0 +1,150 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+//
+//  Regression test for the vocoder silence fast path. A P25 call with a long
+//  pause (which takes the fast path) and a short one (which does not) is
+//  transcoded to DMR AMBE. Every emitted frame is decoded by a stand-in for the
+//  far end, and the parameters it reconstructs must match the ones the encoder
+//  quantized; the AMBE spectral amplitudes are predicted from the previous
+//  frame, so any frame where the two differ leaves speech after the pause
+//  predicted against the wrong history.
+//
+#include "Defines.h"
+#include "p25/P25Defines.h"
+#include "vocoder/VocoderContext.h"
+
+using namespace vocoder;
+
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint8_t   BIT_MASK_TABLE[] = { 0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U };
+
+const uint8_t   TAG_DATA = 0x01U;
+
+const uint32_t  FRAME_SAMPLES = 160U;
+
+// run lengths of the call; even entries are speech, odd entries are silence
+const uint32_t  CALL_RUNS[] = { 30U, 12U, 30U, 2U, 20U };
+const uint32_t  CALL_RUN_COUNT = sizeof(CALL_RUNS) / sizeof(CALL_RUNS[0]);
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>Fills a frame with a voiced test signal.</summary>
+/// <param name="n">Frame number.</param>
+/// <param name="phase">Running fundamental phase.</param>
+/// <param name="samples"></param>
+static void synthesizeFrame(uint32_t n, float* phase, int16_t* samples)
+{
+    float pitch = 100.0f + 3.0f * (float)(n % 40U);
+
+    for (uint32_t i = 0U; i < FRAME_SAMPLES; i++) {
+        *phase += 2.0f * (float)M_PI * pitch / 8000.0f;
+        if (*phase > 2.0f * (float)M_PI)
+            *phase -= 2.0f * (float)M_PI;
+
+        float s = 0.0f;
+        for (uint32_t h = 1U; h <= 10U; h++)
+            s += ::sinf(*phase * (float)h) / (float)h;
+
+        samples[i] = (int16_t)(s * 5000.0f);
+    }
+}
+
+/// <summary>Transcodes the test call and checks the far end stays in step with the encoder.</summary>
+/// <param name="name"></param>
+/// <param name="mode">Transcode mode.</param>
+/// <param name="compare">Flag indicating the A/B comparison chain should run alongside.</param>
+/// <returns>Number of frames where the far end and the encoder disagreed.</returns>
+static uint32_t runCall(const char* name, TRANSCODE_MODE mode, bool compare)
+{
+    MBEEncoder source(ENCODE_88BIT_IMBE);
+    VocoderContext context(DECODE_88BIT_IMBE, ENCODE_DMR_AMBE, 1.0f, mode, compare);
+    MBEDecoder farEnd(DECODE_DMR_AMBE);
+
+    uint32_t n = 0U, mismatches = 0U;
+    float phase = 0.0f;
+
+    for (uint32_t run = 0U; run < CALL_RUN_COUNT; run++) {
+        bool silence = (run & 1U) == 1U;
+        for (uint32_t i = 0U; i < CALL_RUNS[run]; i++, n++) {
+            uint8_t codeword[11U];
+            if (silence) {
+                ::memcpy(codeword, p25::P25_NULL_IMBE, 11U);
+            }
+            else {
+                int16_t samples[FRAME_SAMPLES];
+                synthesizeFrame(n, &phase, samples);
+                source.encode(samples, codeword);
+            }
+
+            uint8_t output[9U];
+            context.transcode(codeword, output);
+
+            mbe_parms parms;
+            farEnd.decodeParms(output, &parms);
+
+            // the far end returns the reconstructed parameters before its own enhancement of the amplitudes
+            const mbe_parms* quantized = context.encoder()->quantizedParms();
+            bool match = parms.L == quantized->L && parms.gamma == quantized->gamma;
+            for (int l = 1; match && l <= parms.L; l++) {
+                if (parms.log2Ml[l] != quantized->log2Ml[l])
+                    match = false;
+            }
+
+            if (!match) {
+                if (mismatches == 0U) {
+                    ::fprintf(stdout, "%s: frame %u (%s run %u, frame %u) decodes to L %d gamma %f, encoder quantized L %d gamma %f\n",
+                        name, n, silence ? "silence" : "speech", run, i, parms.L, parms.gamma, quantized->L, quantized->gamma);
+                }
+
+                mismatches++;
+            }
+        }
+    }
+
+    ::fprintf(stdout, "%s: %u frames, %u out of step with the encoder\n", name, n, mismatches);
+    return mismatches;
+}
+
+/// <summary>Application entry point.</summary>
+/// <returns>Zero if the far end stayed in step with the encoder for every frame, otherwise one.</returns>
+int main()
+{
+    uint32_t failures = 0U;
+    failures += runCall("PCM", TRANSCODE_PCM, false);
+    failures += runCall("parametric", TRANSCODE_PARAMETRIC, false);
+    failures += runCall("PCM with A/B", TRANSCODE_PCM, true);
+
+    return (failures == 0U) ? 0 : 1;
+}
@@ -30,6 +30,7 @@
 
 #include "edac/Golay24128.h"
 #include "vocoder/MBEDecoder.h"
+#include "Utils.h"
 
 using namespace edac;
 using namespace vocoder;
@@ -79,9 +80,112 @@ const int MBEDecoder::rZ[36] = {
     13, 2, 12, 1, 11, 0
 };
 
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+//      Packed-bit tables for the DMR AMBE front end. deinterleave[n][v][r] is
+//      the contribution of value v in nibble n of the codeword to row r of the
+//      4x24 AMBE frame (bit c of a row word is column c), and prng[c0] is the
+//      mask the C0 data c0 demodulates row 1 with.
+// ---------------------------------------------------------------------------
+
+struct AmbeFrontEndTables {
+    uint32_t deinterleave[18][16][4];
+    uint32_t prng[4096];
+
+    AmbeFrontEndTables(const int* w, const int* x, const int* y, const int* z)
+    {
+        ::memset(deinterleave, 0x00, sizeof(deinterleave));
+        for (uint32_t n = 0U; n < 18U; n++) {
+            for (uint32_t v = 0U; v < 16U; v++) {
+                for (uint32_t t = 0U; t < 4U; t++) {
+                    if (((v >> t) & 1U) == 0U)
+                        continue;
+
+                    // odd bits of each byte go to (w, x), even bits to (y, z); pairs run MSB first
+                    uint32_t bit = t + (((n & 1U) == 0U) ? 4U : 0U);
+                    uint32_t k = ((n >> 1) * 4U) + ((7U - bit) / 2U);
+                    if (bit & 1U)
+                        deinterleave[n][v][w[k]] |= 1U << x[k];
+                    else
+                        deinterleave[n][v][y[k]] |= 1U << z[k];
+                }
+            }
+        }
+
+        // the same recurrence as mbe_demodulateAmbe3600x2450Data(); step k flips column 23 - k
+        for (uint32_t c0 = 0U; c0 < 4096U; c0++) {
+            uint32_t pr = 16U * c0;
+            uint32_t mask = 0U;
+            for (uint32_t k = 1U; k < 24U; k++) {
+                pr = ((173U * pr) + 13849U) & 0xFFFFU;
+                mask |= (pr >> 15) << (23U - k);
+            }
+
+            prng[c0] = mask;
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+//      Byte to bit-per-char expansion, MSB first, as mbelib takes its frames.
+// ---------------------------------------------------------------------------
+
+struct MbeBitExpandTable {
+    char bits[256][8];
+
+    MbeBitExpandTable()
+    {
+        for (uint32_t v = 0U; v < 256U; v++) {
+            for (uint32_t j = 0U; j < 8U; j++) {
+                bits[v][j] = (char)((v >> (7U - j)) & 1U);
+            }
+        }
+    }
+};
+
+static const MbeBitExpandTable& bitExpandTable()
+{
+    static const MbeBitExpandTable table;
+    return table;
+}
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+//      Decoder state as left by mbe_initMbeParms() and mbe_initState(); built
+//      once and copied into every decoder on construction and reset.
+// ---------------------------------------------------------------------------
+
+struct MbeInitialParms {
+    mbe_parms cur;
+    mbe_parms prev;
+    mbe_parms prevEnhanced;
+    mbe_state state;
+
+    MbeInitialParms()
+    {
+        ::memset(this, 0x00, sizeof(MbeInitialParms));
+        mbe_initMbeParms(&cur, &prev, &prevEnhanced);
+        mbe_initState(&state, 1U);
+    }
+};
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
+/// <summary>
+/// Returns the parameters and synthesis state to their initial values.
+/// </summary>
+void mbelibParms::reset()
+{
+    static const MbeInitialParms initial;
+
+    *m_cur_mp = initial.cur;
+    *m_prev_mp = initial.prev;
+    *m_prev_mp_enhanced = initial.prevEnhanced;
+    m_state = initial.state;
+}
+
 /// <summary>
 /// Initializes a new instance of the MBEDecoder class.
 /// </summary>
@@ -92,7 +196,6 @@ MBEDecoder::MBEDecoder(MBE_DECODER_MODE mode) :
     m_gainAdjust(1.0f)
 {
     m_mbelibParms = new mbelibParms();
-    mbe_initMbeParms(m_mbelibParms->m_cur_mp, m_mbelibParms->m_prev_mp, m_mbelibParms->m_prev_mp_enhanced);
 }
 
 /// <summary>
@@ -103,6 +206,14 @@ MBEDecoder::~MBEDecoder()
     delete m_mbelibParms;
 }
 
+/// <summary>
+/// Returns the decoder to its initial state, discarding the synthesis history of the previous call.
+/// </summary>
+void MBEDecoder::reset()
+{
+    m_mbelibParms->reset();
+}
+
 /// <summary>
 /// Decodes the given MBE codewords to PCM samples using the decoder mode.
 /// </summary>
@@ -120,52 +231,26 @@ int32_t MBEDecoder::decode(uint8_t* codeword, int16_t samples[])
     case DECODE_DMR_AMBE:
         {
             char ambe_d[49U];
-            char ambe_fr[4][24];
-            ::memset(ambe_d, 0x00U, 49U);
-            ::memset(ambe_fr, 0x00U, 96U);
-
-            const int* w, *x, *y, *z;
-
-            w = rW;
-            x = rX;
-            y = rY;
-            z = rZ;
-
-            for (int i = 0; i < 9; ++i) {
-                for (int j = 0; j < 8; j += 2) {
-                    ambe_fr[*y][*z] = (1 & (codeword[i] >> (7 - (j + 1))));
-                    ambe_fr[*w][*x] = (1 & (codeword[i] >> (7 - j)));
-                    w++;
-                    x++;
-                    y++;
-                    z++;
-                }
-            }
-
             int ambeErrs;
+            decodeDmrAMBE(codeword, ambe_d, &ambeErrs, &errs);
+
             char ambeErrStr[64U];
             ::memset(ambeErrStr, 0x20U, 64U);
 
-            mbe_processAmbe3600x2450FrameF(audioOutBuf, &ambeErrs, &errs, ambeErrStr, ambe_fr, ambe_d, m_mbelibParms->m_cur_mp, m_mbelibParms->m_prev_mp, m_mbelibParms->m_prev_mp_enhanced, 3);
+            mbe_processAmbe2450DataF(audioOutBuf, &ambeErrs, &errs, ambeErrStr, ambe_d, m_mbelibParms->m_cur_mp, m_mbelibParms->m_prev_mp, m_mbelibParms->m_prev_mp_enhanced, 3, &m_mbelibParms->m_state);
         }
         break;
 
     case DECODE_88BIT_IMBE:
         {
             char imbe_d[88U];
-            ::memset(imbe_d, 0x00U, 88U);
-
-            for (int i = 0; i < 11; ++i) {
-                for (int j = 0; j < 8; j++) {
-                    imbe_d[j + (8 * i)] = (1 & (codeword[i] >> (7 - j)));
-                }
-            }
+            unpackIMBE(codeword, imbe_d);
 
             int ambeErrs;
             char ambeErrStr[64U];
             ::memset(ambeErrStr, 0x20U, 64U);
 
-            mbe_processImbe4400DataF(audioOutBuf, &ambeErrs, &errs, ambeErrStr, imbe_d, m_mbelibParms->m_cur_mp, m_mbelibParms->m_prev_mp, m_mbelibParms->m_prev_mp_enhanced, 3);
+            mbe_processImbe4400DataF(audioOutBuf, &ambeErrs, &errs, ambeErrStr, imbe_d, m_mbelibParms->m_cur_mp, m_mbelibParms->m_prev_mp, m_mbelibParms->m_prev_mp_enhanced, 3, &m_mbelibParms->m_state);
         }
         break;
     }
@@ -190,3 +275,123 @@ int32_t MBEDecoder::decode(uint8_t* codeword, int16_t samples[])
 
     return errs;
 }
+
+/// <summary>
+/// Decodes the given MBE codewords to model parameters using the decoder mode, without synthesizing speech.
+/// </summary>
+/// <remarks>
+/// The returned parameters are the enhanced parameters speech would be synthesized from, with the spectral
+/// amplitudes (Ml) scaled by the gain adjustment. A frame that decodes to silence (erasure, tone or too many
+/// repeats) is returned with L set to zero.
+/// </remarks>
+/// <param name="codeword"></param>
+/// <param name="parms"></param>
+/// <returns></returns>
+int32_t MBEDecoder::decodeParms(uint8_t* codeword, mbe_parms* parms)
+{
+    int32_t errs = 0;
+    int voice = 0;
+
+    int ambeErrs;
+    char ambeErrStr[64U];
+    ::memset(ambeErrStr, 0x20U, 64U);
+
+    mbe_parms* cur_mp = m_mbelibParms->m_cur_mp;
+
+    switch (m_mbeMode)
+    {
+    case DECODE_DMR_AMBE:
+        {
+            char ambe_d[49U];
+            decodeDmrAMBE(codeword, ambe_d, &ambeErrs, &errs);
+
+            voice = mbe_processAmbe2450Parms(&ambeErrs, &errs, ambeErrStr, ambe_d, cur_mp, m_mbelibParms->m_prev_mp, m_mbelibParms->m_prev_mp_enhanced);
+        }
+        break;
+
+    case DECODE_88BIT_IMBE:
+        {
+            char imbe_d[88U];
+            unpackIMBE(codeword, imbe_d);
+
+            voice = mbe_processImbe4400Parms(&ambeErrs, &errs, ambeErrStr, imbe_d, cur_mp, m_mbelibParms->m_prev_mp, m_mbelibParms->m_prev_mp_enhanced);
+        }
+        break;
+    }
+
+    ::memcpy(parms, cur_mp, sizeof(mbe_parms));
+    if (!voice) {
+        parms->L = 0;
+        return errs;
+    }
+
+    mbe_moveMbeParms(cur_mp, m_mbelibParms->m_prev_mp_enhanced);
+
+    for (int l = 1; l <= parms->L; l++) {
+        parms->Ml[l] *= m_gainAdjust;
+    }
+
+    return errs;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+/// <summary>
+/// Helper to deinterleave, error correct and demodulate DMR AMBE codewords into AMBE data bits.
+/// </summary>
+/// <remarks>This is the packed-bit equivalent of mbe_eccAmbe3600x2450C0(), mbe_demodulateAmbe3600x2450Data()
+/// and mbe_eccAmbe3600x2450Data() run on the deinterleaved frame, and produces identical data bits and error
+/// counts.</remarks>
+/// <param name="codeword"></param>
+/// <param name="ambe_d"></param>
+/// <param name="errs">Number of errors corrected in C0.</param>
+/// <param name="errs2">Number of errors corrected in C0 and C1.</param>
+void MBEDecoder::decodeDmrAMBE(const uint8_t* codeword, char ambe_d[49], int* errs, int* errs2)
+{
+    static const AmbeFrontEndTables tables(rW, rX, rY, rZ);
+
+    uint32_t fr[4] = { 0U, 0U, 0U, 0U };
+    for (uint32_t n = 0U; n < 18U; n++) {
+        uint32_t v = (codeword[n >> 1] >> (((n & 1U) == 0U) ? 4U : 0U)) & 0x0FU;
+        const uint32_t* bits = tables.deinterleave[n][v];
+        fr[0] |= bits[0];
+        fr[1] |= bits[1];
+        fr[2] |= bits[2];
+        fr[3] |= bits[3];
+    }
+
+    // C0 is Golay (24,12) with its parity bit in column 0, which is not checked
+    uint32_t c0 = (fr[0] >> 1) & 0x7FFFFFU;
+    uint32_t c0Data = Golay24128::decode23127(c0);
+    *errs = Utils::countBits32(c0Data ^ (c0 >> 11));
+
+    // C1 is Golay (23,12), modulated by a PRNG seeded from the C0 data
+    uint32_t c1 = (fr[1] ^ tables.prng[c0Data]) & 0x7FFFFFU;
+    uint32_t c1Data = Golay24128::decode23127(c1);
+    *errs2 = *errs + Utils::countBits32(c1Data ^ (c1 >> 11));
+
+    // C0 and C1 data, C2 columns 10..0 and C3 columns 13..0, MSB first
+    ulong64_t d = ((ulong64_t)c0Data << 37) | ((ulong64_t)c1Data << 25) | ((ulong64_t)(fr[2] & 0x7FFU) << 14) | (fr[3] & 0x3FFFU);
+
+    const MbeBitExpandTable& expand = bitExpandTable();
+    char bits[56U];
+    for (uint32_t i = 0U; i < 7U; i++) {
+        ::memcpy(bits + (i * 8U), expand.bits[(d >> (48U - (i * 8U))) & 0xFFU], 8U);
+    }
+
+    ::memcpy(ambe_d, bits + 7U, 49U);
+}
+
+/// <summary>
+/// Helper to unpack IMBE codewords into IMBE data bits.
+/// </summary>
+/// <param name="codeword"></param>
+/// <param name="imbe_d"></param>
+void MBEDecoder::unpackIMBE(const uint8_t* codeword, char imbe_d[88])
+{
+    const MbeBitExpandTable& expand = bitExpandTable();
+    for (int i = 0; i < 11; ++i) {
+        ::memcpy(imbe_d + (8 * i), expand.bits[codeword[i]], 8U);
+    }
+}
@@ -48,12 +48,16 @@ namespace vocoder
         mbe_parms* m_prev_mp;
         mbe_parms* m_prev_mp_enhanced;
 
+        mbe_state m_state;
+
         /// <summary></summary>
         mbelibParms()
         {
             m_cur_mp = (mbe_parms*)malloc(sizeof(mbe_parms));
             m_prev_mp = (mbe_parms*)malloc(sizeof(mbe_parms));
             m_prev_mp_enhanced = (mbe_parms*)malloc(sizeof(mbe_parms));
+
+            reset();
         }
 
         /// <summary></summary>
@@ -63,6 +67,9 @@ namespace vocoder
             free(m_prev_mp);
             free(m_cur_mp);
         }
+
+        /// <summary>Returns the parameters and synthesis state to their initial values.</summary>
+        void reset();
     };
 
     // ---------------------------------------------------------------------------
@@ -87,8 +94,13 @@ namespace vocoder
         /// <summary>Finalizes a instance of the MBEDecoder class.</summary>
         ~MBEDecoder();
 
+        /// <summary>Returns the decoder to its initial state, discarding the synthesis history of the previous call.</summary>
+        void reset();
+
         /// <summary>Decodes the given MBE codewords to PCM samples using the decoder mode.</summary>
         int32_t decode(uint8_t* codeword, int16_t samples[]);
+        /// <summary>Decodes the given MBE codewords to model parameters using the decoder mode, without synthesizing speech.</summary>
+        int32_t decodeParms(uint8_t* codeword, mbe_parms* parms);
 
     private:
         mbelibParms* m_mbelibParms;
@@ -102,6 +114,11 @@ namespace vocoder
         static const int rY[36];
         static const int rZ[36];
 
+        /// <summary>Helper to deinterleave, error correct and demodulate DMR AMBE codewords into AMBE data bits.</summary>
+        void decodeDmrAMBE(const uint8_t* codeword, char ambe_d[49], int* errs, int* errs2);
+        /// <summary>Helper to unpack IMBE codewords into IMBE data bits.</summary>
+        void unpackIMBE(const uint8_t* codeword, char imbe_d[88]);
+
     public:
         /// <summary></summary>
         __PROPERTY(float, gainAdjust, GainAdjust);
@@ -35,6 +35,7 @@
 #include "edac/AMBEFEC.h"
 #include "edac/Golay24128.h"
 #include "vocoder/MBEEncoder.h"
+#include "vocoder/VQSearch.h"
 #include "vocoder/ambe3600x2450_const.h"
 #include "vocoder/ambe3600x2400_const.h"
 
@@ -52,6 +53,11 @@ using namespace vocoder;
 //  Constants
 // ---------------------------------------------------------------------------
 
+// Spectral amplitude the IMBE analysis measures for a harmonic mbelib synthesizes
+// at unit amplitude; lets decoded model parameters skip the synthesis/analysis pass
+const float VOICED_SA_GAIN = 2.0f;
+const float UNVOICED_SA_GAIN = 3.6f;
+
 static const short b0_lookup[] = {
     0, 0, 0, 1, 1, 2, 2, 2,
     3, 3, 4, 4, 4, 5, 5, 5,
@@ -159,10 +165,96 @@ static const short b0_lookup[] = {
     119, 119, 119
 };
 
+const uint32_t AMBE_VUV_MAX = 17U;
+const uint32_t AMBE_VUV_PADDED = ((AMBE_VUV_MAX + VQ_LANES - 1U) / VQ_LANES) * VQ_LANES;
+
+const int AMBE_DCT_MAX = 17;    // largest block length in AmbeLmprbl
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+//      V/UV codebook mismatch masks, indexed by band decision and codebook
+//      column; each row holds one mask per codebook entry.
+// ---------------------------------------------------------------------------
+
+struct AmbeVuvMasks {
+    uint32_t mask[2][8][AMBE_VUV_PADDED];
+
+    AmbeVuvMasks()
+    {
+        for (uint32_t v = 0U; v < 2U; v++) {
+            for (uint32_t jl = 0U; jl < 8U; jl++) {
+                for (uint32_t n = 0U; n < AMBE_VUV_PADDED; n++) {
+                    mask[v][jl][n] = (n < AMBE_VUV_MAX && (int)v != AmbeVuv[n][jl]) ? 0xFFFFFFFFU : 0U;
+                }
+            }
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+//      Cosine kernels for the spectral amplitude transforms. dct[J][j][k] is
+//      the weight of input j in output k of the J-point block DCT, and
+//      prba[i][m] is the weight of R[i] in G[m]; the arguments are computed
+//      exactly as the per-frame cosf() calls they replace were.
+// ---------------------------------------------------------------------------
+
+struct AmbeDctTables {
+    float dct[AMBE_DCT_MAX + 1][AMBE_DCT_MAX][AMBE_DCT_MAX];
+    float prba[8][8];
+
+    AmbeDctTables()
+    {
+        ::memset(dct, 0x00, sizeof(dct));
+        for (int J = 1; J <= AMBE_DCT_MAX; J++) {
+            for (int j = 1; j <= J; j++) {
+                for (int k = 1; k <= J; k++) {
+                    dct[J][j - 1][k - 1] = cosf((M_PI * (((float)k) - 1.0) * (((float)j) - 0.5)) / (float)J);
+                }
+            }
+        }
+
+        for (int i = 1; i <= 8; i++) {
+            for (int m = 1; m <= 8; m++) {
+                prba[i - 1][m - 1] = cosf((M_PI * (((float)m) - 1.0) * (((float)i) - 0.5)) / 8.0);
+            }
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+//      Model parameter history as left by mbe_initMbeParms(); built once and
+//      copied into every encoder on construction and reset.
+// ---------------------------------------------------------------------------
+
+struct AmbeInitialParms {
+    mbe_parms cur;
+    mbe_parms prev;
+
+    AmbeInitialParms()
+    {
+        mbe_parms enh;
+        ::memset(this, 0x00, sizeof(AmbeInitialParms));
+        ::memset(&enh, 0x00, sizeof(mbe_parms));
+        mbe_initMbeParms(&cur, &prev, &enh);
+    }
+};
+
 // ---------------------------------------------------------------------------
 //  Global Functions
 // ---------------------------------------------------------------------------
 
+/// <summary>
+/// Helper to return the initial model parameter history.
+/// </summary>
+/// <returns></returns>
+static const AmbeInitialParms& initialParms()
+{
+    static const AmbeInitialParms parms;
+    return parms;
+}
+
 /// <summary>
 /// 
 /// </summary>
@@ -207,27 +299,26 @@ static void encodeAMBE(const IMBE_PARAM* imbe_param, int b[], mbe_parms* cur_mp,
         m_float2[l - 1] = m_float2[l - 1] * m_float2[l - 1];
     }
 
-    float en_min = 0;
-    b[1] = 0;
-    int vuv_max = 17;
-    for (int n = 0; n < vuv_max; n++) {
-        float En = 0;
-        for (int l = 1; l <= L; l++) {
-            int jl = (int)((float)l * (float)16.0 * AmbeW0table[b[0]]);
-            int kl = 12;
-            if (l <= 36)
-                kl = (l + 2) / 3;
-
-            if (imbe_param->v_uv_dsn[(kl - 1) * 3] != AmbeVuv[n][jl])
-                En += m_float2[l - 1];
-        }
+    static const AmbeVuvMasks vuvMasks;
+
+    float En[AMBE_VUV_PADDED];
+    for (uint32_t n = 0U; n < AMBE_VUV_PADDED; n++)
+        En[n] = 0.0f;
+
+    for (int l = 1; l <= L; l++) {
+        int jl = (int)((float)l * (float)16.0 * AmbeW0table[b[0]]);
+        int kl = 12;
+        if (l <= 36)
+            kl = (l + 2) / 3;
+
+        uint32_t v = (imbe_param->v_uv_dsn[(kl - 1) * 3] != 0) ? 1U : 0U;
+        VQCodebook::accumulate(En, vuvMasks.mask[v][jl], m_float2[l - 1], AMBE_VUV_PADDED);
+    }
 
-        if (n == 0)
-            en_min = En;
-        else if (En < en_min) {
+    b[1] = 0;
+    for (uint32_t n = 1U; n < AMBE_VUV_MAX; n++) {
+        if (En[n] < En[b[1]])
             b[1] = n;
-            en_min = En;
-        }
     }
 
     // log spectral amplitudes
@@ -252,18 +343,8 @@ static void encodeAMBE(const IMBE_PARAM* imbe_param, int b[], mbe_parms* cur_mp,
 
     diff_gain -= gainAdjust;
 
-    float error;
-    int error_index;
-    int max_dg = 32;
-    for (int i1 = 0; i1 < max_dg; i1++) {
-        float diff = fabsf(diff_gain - AmbeDg[i1]);
-        if ((i1 == 0) || (diff < error)) {
-            error = diff;
-            error_index = i1;
-        }
-    }
-
-    b[2] = error_index;
+    static const VQCodebook dg(AmbeDg, 32U, 1U);
+    b[2] = dg.searchAbs(diff_gain);
 
     // prediction residuals
     float l_prev_l = (float)(prev_mp->L) / num_harms_f;
@@ -294,16 +375,27 @@ static void encodeAMBE(const IMBE_PARAM* imbe_param, int b[], mbe_parms* cur_mp,
         acc += J[i];
     }
 
-    float C[4][17];
-    for (int i = 1; i <= 4; i++) {
-        for (int k = 1; k <= J[i - 1]; k++) {
-            float s = 0.0;
-            for (int j = 1; j <= J[i - 1]; j++) {
-                //fixme: lut?
-                s += (c[i - 1][j - 1] * cosf((M_PI * (((float)k) - 1.0) * (((float)j) - 0.5)) / (float)J[i - 1]));
-            }
-            C[i - 1][k - 1] = s / (float)J[i - 1];
+    // block DCTs; each input row is scaled into all of its outputs at once, which
+    // keeps the per-output summation order of the direct form
+    static const AmbeDctTables dctTables;
+
+    float C[4][AMBE_DCT_MAX];
+    for (int i = 0; i < 4; i++) {
+        const int Ji = J[i];
+
+        float s[AMBE_DCT_MAX];
+        for (int k = 0; k < Ji; k++)
+            s[k] = 0.0f;
+
+        for (int j = 0; j < Ji; j++) {
+            const float cj = c[i][j];
+            const float* kernel = dctTables.dct[Ji][j];
+            for (int k = 0; k < Ji; k++)
+                s[k] += (cj * kernel[k]);
         }
+
+        for (int k = 0; k < Ji; k++)
+            C[i][k] = s[k] / (float)Ji;
     }
 
     float R[8];
@@ -318,140 +410,41 @@ static void encodeAMBE(const IMBE_PARAM* imbe_param, int b[], mbe_parms* cur_mp,
 
     // encode PRBA
     float G[8];
-    for (int m = 1; m <= 8; m++) {
-        G[m - 1] = 0.0;
-        for (int i = 1; i <= 8; i++) {
-            //fixme: lut?
-            G[m - 1] += (R[i - 1] * cosf((M_PI * (((float)m) - 1.0) * (((float)i) - 0.5)) / 8.0));
-        }
-        G[m - 1] /= 8.0;
+    for (int m = 0; m < 8; m++)
+        G[m] = 0.0f;
+
+    for (int i = 0; i < 8; i++) {
+        const float ri = R[i];
+        const float* kernel = dctTables.prba[i];
+        for (int m = 0; m < 8; m++)
+            G[m] += (ri * kernel[m]);
     }
 
-    for (int i = 0; i < 512; i++) {
-        float err = 0.0;
-        float diff;
-
-        diff = G[1] - AmbePRBA24[i][0];
-        err += (diff * diff);
-        diff = G[2] - AmbePRBA24[i][1];
-        err += (diff * diff);
-        diff = G[3] - AmbePRBA24[i][2];
-        err += (diff * diff);
+    for (int m = 0; m < 8; m++)
+        G[m] /= 8.0;
 
-        if (i == 0 || err < error) {
-            error = err;
-            error_index = i;
-        }
-    }
-
-    b[3] = error_index;
+    static const VQCodebook prba24(&AmbePRBA24[0][0], 512U, 3U);
+    b[3] = prba24.search(&G[1], 3U);
 
     // PRBA58
-    for (int i = 0; i < 128; i++) {
-        float err = 0.0;
-        float diff;
-
-        diff = G[4] - AmbePRBA58[i][0];
-        err += (diff * diff);
-        diff = G[5] - AmbePRBA58[i][1];
-        err += (diff * diff);
-        diff = G[6] - AmbePRBA58[i][2];
-        err += (diff * diff);
-        diff = G[7] - AmbePRBA58[i][3];
-        err += (diff * diff);
-
-        if (i == 0 || err < error) {
-            error = err;
-            error_index = i;
+    static const VQCodebook prba58(&AmbePRBA58[0][0], 128U, 4U);
+    b[4] = prba58.search(&G[4], 4U);
+
+    // higher order coeffs b5 - b8
+    static const VQCodebook hocb5(&AmbeHOCb5[0][0], 32U, 4U);
+    static const VQCodebook hocb6(&AmbeHOCb6[0][0], 16U, 4U);
+    static const VQCodebook hocb7(&AmbeHOCb7[0][0], 16U, 4U);
+    static const VQCodebook hocb8(&AmbeHOCb8[0][0], 8U, 4U);
+    static const VQCodebook* hocb[4] = { &hocb5, &hocb6, &hocb7, &hocb8 };
+
+    for (int ii = 1; ii <= 4; ii++) {
+        if (J[ii - 1] <= 2) {
+            b[4 + ii] = 0;
         }
-    }
-
-    b[4] = error_index;
-
-    // higher order coeffs b5
-    int ii = 1;
-    if (J[ii - 1] <= 2) {
-        b[4 + ii] = 0.0;
-    }
-    else {
-        int max_5 = 32;
-        for (int n = 0; n < max_5; n++) {
-            float err = 0.0;
-            float diff;
-            for (int j = 1; j <= J[ii - 1] - 2 && j <= 4; j++) {
-                diff = AmbeHOCb5[n][j - 1] - C[ii - 1][j + 2 - 1];
-                err += (diff * diff);
-            }
-            if (n == 0 || err < error) {
-                error = err;
-                error_index = n;
-            }
+        else {
+            uint32_t dims = (J[ii - 1] - 2 < 4) ? (uint32_t)(J[ii - 1] - 2) : 4U;
+            b[4 + ii] = hocb[ii - 1]->search(&C[ii - 1][2], dims);
         }
-        b[4 + ii] = error_index;
-    }
-
-    // higher order coeffs b6
-    ii = 2;
-    if (J[ii - 1] <= 2) {
-        b[4 + ii] = 0.0;
-    }
-    else {
-        for (int n = 0; n < 16; n++) {
-            float err = 0.0;
-            float diff;
-            for (int j = 1; j <= J[ii - 1] - 2 && j <= 4; j++) {
-                diff = AmbeHOCb6[n][j - 1] - C[ii - 1][j + 2 - 1];
-                err += (diff * diff);
-            }
-            if (n == 0 || err < error) {
-                error = err;
-                error_index = n;
-            }
-        }
-        b[4 + ii] = error_index;
-    }
-
-    // higher order coeffs b7
-    ii = 3;
-    if (J[ii - 1] <= 2) {
-        b[4 + ii] = 0.0;
-    }
-    else {
-        for (int n = 0; n < 16; n++) {
-            float err = 0.0;
-            float diff;
-            for (int j = 1; j <= J[ii - 1] - 2 && j <= 4; j++) {
-                diff = AmbeHOCb7[n][j - 1] - C[ii - 1][j + 2 - 1];
-                err += (diff * diff);
-            }
-            if (n == 0 || err < error) {
-                error = err;
-                error_index = n;
-            }
-        }
-        b[4 + ii] = error_index;
-    }
-
-    // higher order coeffs b8
-    ii = 4;
-    if (J[ii - 1] <= 2) {
-        b[4 + ii] = 0.0;
-    }
-    else {
-        int max_8 = 8;
-        for (int n = 0; n < max_8; n++) {
-            float err = 0.0;
-            float diff;
-            for (int j = 1; j <= J[ii - 1] - 2 && j <= 4; j++) {
-                diff = AmbeHOCb8[n][j - 1] - C[ii - 1][j + 2 - 1];
-                err += (diff * diff);
-            }
-            if (n == 0 || err < error) {
-                error = err;
-                error_index = n;
-            }
-        }
-        b[4 + ii] = error_index;
     }
 
     mbe_dequantizeAmbe2250Parms(cur_mp, prev_mp, b);
@@ -578,12 +571,24 @@ static void encodeDmrAMBE(const uint8_t* in, uint8_t* out)
 /// Initializes a new instance of the MBEDecoder class.
 /// </summary>
 /// <param name="mode"></param>
-MBEEncoder::MBEEncoder(MBE_ENCODER_MODE mode) :
+/// <param name="floatFFT">Flag indicating speech analysis should use the float FFT instead of the bit-exact fixed-point FFT.</param>
+MBEEncoder::MBEEncoder(MBE_ENCODER_MODE mode, bool floatFFT) :
+    m_vocoder(floatFFT ? IMBE_FFT_FLOAT : IMBE_FFT_FIXED),
     m_mbeMode(mode),
     m_gainAdjust(0.0f)
 {
-    mbe_parms enh_mp;
-    mbe_initMbeParms(&m_curMBEParms, &m_prevMBEParms, &enh_mp);
+    m_curMBEParms = initialParms().cur;
+    m_prevMBEParms = initialParms().prev;
+}
+
+/// <summary>
+/// Returns the encoder to its initial state, discarding the speech history of the previous call.
+/// </summary>
+void MBEEncoder::reset()
+{
+    m_vocoder.reset();
+    m_curMBEParms = initialParms().cur;
+    m_prevMBEParms = initialParms().prev;
 }
 
 /// <summary>
@@ -597,6 +602,59 @@ void MBEEncoder::encode(int16_t samples[], uint8_t codeword[])
 
     // first do speech analysis to generate mbe model parameters
     m_vocoder.imbe_encode(frame_vector, samples);
+    encodeCodeword(frame_vector, codeword);
+}
+
+/// <summary>
+/// Encodes the given MBE model parameters using the encoder mode to MBE codewords, without speech analysis.
+/// </summary>
+/// <remarks>The parameters are expected as returned by MBEDecoder::decodeParms(). Parameters with L set to
+/// zero are encoded as silence.</remarks>
+/// <param name="parms"></param>
+/// <param name="codeword"></param>
+void MBEEncoder::encodeParms(const mbe_parms* parms, uint8_t codeword[])
+{
+    if (parms->L <= 0) {
+        int16_t samples[160U];
+        ::memset(samples, 0x00U, sizeof(samples));
+        encode(samples, codeword);
+        return;
+    }
+
+    IMBE_PARAM src;
+    ::memset(&src, 0x00U, sizeof(IMBE_PARAM));
+
+    // pitch period (in samples) in Q8.8; out of range values are clamped by the quantizer
+    float pitch = (2.0f * (float)M_PI / parms->w0) * 256.0f;
+    src.ref_pitch = (pitch > 32767.0f) ? 32767 : (Word16)pitch;
+
+    src.num_harms = (parms->L > NUM_HARMS_MAX) ? NUM_HARMS_MAX : parms->L;
+    for (int l = 1; l <= src.num_harms; l++) {
+        float sa = parms->Ml[l] * ((parms->Vl[l] == 1) ? VOICED_SA_GAIN : UNVOICED_SA_GAIN);
+        if (sa < 1.0f)
+            sa = 1.0f;
+        else if (sa > 32767.0f)
+            sa = 32767.0f;
+
+        src.sa[l - 1] = (Word16)sa;
+        src.v_uv_dsn[l - 1] = (parms->Vl[l] == 1) ? 1 : 0;
+    }
+
+    int16_t frame_vector[8];
+    m_vocoder.imbe_encode_param(frame_vector, &src);
+    encodeCodeword(frame_vector, codeword);
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+/// <summary>
+/// Helper to build MBE codewords from the model parameters last quantized by the IMBE vocoder.
+/// </summary>
+/// <param name="frame_vector"></param>
+/// <param name="codeword"></param>
+void MBEEncoder::encodeCodeword(const int16_t frame_vector[], uint8_t codeword[])
+{
     if (m_mbeMode == ENCODE_88BIT_IMBE) {
         if (m_gainAdjust >= 1.0f) {
             m_vocoder.set_gain_adjust(m_gainAdjust);
@@ -651,10 +709,8 @@ void MBEEncoder::encode(int16_t samples[], uint8_t codeword[])
         uint8_t rawAmbe[9U];
         ::memset(rawAmbe, 0x00U, 9U);
 
-        for (int i = 0; i < 9; ++i) {
-            for (int j = 0; j < 8; ++j) {
-                rawAmbe[i] |= (bits[(i * 8) + j] << (7 - j));
-            }
+        for (int i = 0; i < 49; ++i) {
+            rawAmbe[i / 8] |= (bits[i] << (7 - (i % 8)));
         }
 
         // build DMR AMBE bytes
@@ -50,10 +50,18 @@ namespace vocoder
     class MBEEncoder {
     public:
         /// <summary>Initializes a new instance of the MBEEncoder class.</summary>
-        MBEEncoder(MBE_ENCODER_MODE mode);
+        MBEEncoder(MBE_ENCODER_MODE mode, bool floatFFT = false);
+
+        /// <summary>Returns the encoder to its initial state, discarding the speech history of the previous call.</summary>
+        void reset();
 
         /// <summary>Encodes the given PCM samples using the encoder mode to MBE codewords.</summary>
         void encode(int16_t samples[], uint8_t codeword[]);
+        /// <summary>Encodes the given MBE model parameters using the encoder mode to MBE codewords, without speech analysis.</summary>
+        void encodeParms(const mbe_parms* parms, uint8_t codeword[]);
+
+        /// <summary>Gets the model parameters last quantized into a DMR AMBE codeword, as the far end's decoder reconstructs them.</summary>
+        const mbe_parms* quantizedParms() const { return &m_prevMBEParms; }
 
     private:
         imbe_vocoder m_vocoder;
@@ -62,6 +70,9 @@ namespace vocoder
 
         MBE_ENCODER_MODE m_mbeMode;
 
+        /// <summary>Helper to build MBE codewords from the model parameters last quantized by the IMBE vocoder.</summary>
+        void encodeCodeword(const int16_t frame_vector[], uint8_t codeword[]);
+
     public:
         /// <summary></summary>
         __PROPERTY(float, gainAdjust, GainAdjust);
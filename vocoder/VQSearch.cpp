@@ -0,0 +1,359 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "vocoder/VQSearch.h"
+
+using namespace vocoder;
+
+#if defined(VQ_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(VQ_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(VQ_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <cassert>
+#include <cmath>
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Helper to pick the best of the per-lane search results.
+/// </summary>
+/// <remarks>Each lane holds the first index of its own minimum, so taking the least
+/// error and then the least index gives the first index of the overall minimum.</remarks>
+/// <param name="best"></param>
+/// <param name="index"></param>
+/// <param name="lanes"></param>
+/// <returns></returns>
+static uint32_t reduceLanes(const float* best, const int32_t* index, uint32_t lanes)
+{
+    uint32_t n = 0U;
+    for (uint32_t i = 1U; i < lanes; i++) {
+        if (best[i] < best[n] || (best[i] == best[n] && index[i] < index[n]))
+            n = i;
+    }
+
+    return (uint32_t)index[n];
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+/// <summary>
+/// Initializes a new instance of the VQCodebook class.
+/// </summary>
+/// <param name="table">Codebook in row-major (entry by component) order.</param>
+/// <param name="count">Number of entries in the codebook.</param>
+/// <param name="dims">Number of components of each entry.</param>
+VQCodebook::VQCodebook(const float* table, uint32_t count, uint32_t dims) :
+    m_count(count),
+    m_padded(((count + VQ_LANES - 1U) / VQ_LANES) * VQ_LANES),
+    m_dims(dims),
+    m_data(nullptr)
+{
+    assert(table != nullptr);
+    assert(count > 0U);
+
+    // padding entries are infinitely far from any target and never win a search
+    m_data = new float[m_dims * m_padded];
+    for (uint32_t d = 0U; d < m_dims; d++) {
+        for (uint32_t i = 0U; i < m_padded; i++) {
+            m_data[d * m_padded + i] = (i < m_count) ? table[i * m_dims + d] : HUGE_VALF;
+        }
+    }
+}
+
+/// <summary>
+/// Finalizes a instance of the VQCodebook class.
+/// </summary>
+VQCodebook::~VQCodebook()
+{
+    delete[] m_data;
+}
+
+/// <summary>
+/// Finds the entry with the least squared error to the target over the first components.
+/// </summary>
+/// <param name="target">Target vector.</param>
+/// <param name="dims">Number of leading components to compare.</param>
+/// <returns>Index of the nearest entry.</returns>
+uint32_t VQCodebook::search(const float* target, uint32_t dims) const
+{
+    assert(dims <= m_dims);
+
+#if defined(VQ_SIMD_AVX2)
+    __m256 bestV = _mm256_set1_ps(HUGE_VALF);
+    __m256i bestI = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i idx = bestI;
+    const __m256i step = _mm256_set1_epi32(8);
+
+    for (uint32_t i = 0U; i < m_padded; i += 8U) {
+        __m256 err = _mm256_setzero_ps();
+        for (uint32_t d = 0U; d < dims; d++) {
+            __m256 diff = _mm256_sub_ps(_mm256_set1_ps(target[d]), _mm256_loadu_ps(m_data + d * m_padded + i));
+            err = _mm256_add_ps(err, _mm256_mul_ps(diff, diff));
+        }
+
+        __m256 lt = _mm256_cmp_ps(err, bestV, _CMP_LT_OQ);
+        bestV = _mm256_blendv_ps(bestV, err, lt);
+        bestI = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(bestI), _mm256_castsi256_ps(idx), lt));
+        idx = _mm256_add_epi32(idx, step);
+    }
+
+    float best[8U];
+    int32_t index[8U];
+    _mm256_storeu_ps(best, bestV);
+    _mm256_storeu_si256((__m256i*)index, bestI);
+    return reduceLanes(best, index, 8U);
+#elif defined(VQ_SIMD_SSE2)
+    __m128 bestV = _mm_set1_ps(HUGE_VALF);
+    __m128i bestI = _mm_setr_epi32(0, 1, 2, 3);
+    __m128i idx = bestI;
+    const __m128i step = _mm_set1_epi32(4);
+
+    for (uint32_t i = 0U; i < m_padded; i += 4U) {
+        __m128 err = _mm_setzero_ps();
+        for (uint32_t d = 0U; d < dims; d++) {
+            __m128 diff = _mm_sub_ps(_mm_set1_ps(target[d]), _mm_loadu_ps(m_data + d * m_padded + i));
+            err = _mm_add_ps(err, _mm_mul_ps(diff, diff));
+        }
+
+        __m128 lt = _mm_cmplt_ps(err, bestV);
+        __m128i ltI = _mm_castps_si128(lt);
+        bestV = _mm_or_ps(_mm_and_ps(lt, err), _mm_andnot_ps(lt, bestV));
+        bestI = _mm_or_si128(_mm_and_si128(ltI, idx), _mm_andnot_si128(ltI, bestI));
+        idx = _mm_add_epi32(idx, step);
+    }
+
+    float best[4U];
+    int32_t index[4U];
+    _mm_storeu_ps(best, bestV);
+    _mm_storeu_si128((__m128i*)index, bestI);
+    return reduceLanes(best, index, 4U);
+#elif defined(VQ_SIMD_NEON)
+    static const int32_t LANES[4U] = { 0, 1, 2, 3 };
+
+    float32x4_t bestV = vdupq_n_f32(HUGE_VALF);
+    int32x4_t bestI = vld1q_s32(LANES);
+    int32x4_t idx = bestI;
+    const int32x4_t step = vdupq_n_s32(4);
+
+    for (uint32_t i = 0U; i < m_padded; i += 4U) {
+        float32x4_t err = vdupq_n_f32(0.0f);
+        for (uint32_t d = 0U; d < dims; d++) {
+            float32x4_t diff = vsubq_f32(vdupq_n_f32(target[d]), vld1q_f32(m_data + d * m_padded + i));
+            err = vaddq_f32(err, vmulq_f32(diff, diff));
+        }
+
+        uint32x4_t lt = vcltq_f32(err, bestV);
+        bestV = vbslq_f32(lt, err, bestV);
+        bestI = vbslq_s32(lt, idx, bestI);
+        idx = vaddq_s32(idx, step);
+    }
+
+    float best[4U];
+    int32_t index[4U];
+    vst1q_f32(best, bestV);
+    vst1q_s32(index, bestI);
+    return reduceLanes(best, index, 4U);
+#else
+    return searchScalar(target, dims);
+#endif
+}
+
+/// <summary>
+/// Finds the entry with the least absolute error to the target.
+/// </summary>
+/// <remarks>Only the first component of each entry is compared.</remarks>
+/// <param name="target">Target value.</param>
+/// <returns>Index of the nearest entry.</returns>
+uint32_t VQCodebook::searchAbs(float target) const
+{
+#if defined(VQ_SIMD_AVX2)
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 t = _mm256_set1_ps(target);
+
+    __m256 bestV = _mm256_set1_ps(HUGE_VALF);
+    __m256i bestI = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i idx = bestI;
+    const __m256i step = _mm256_set1_epi32(8);
+
+    for (uint32_t i = 0U; i < m_padded; i += 8U) {
+        __m256 err = _mm256_and_ps(_mm256_sub_ps(t, _mm256_loadu_ps(m_data + i)), absMask);
+
+        __m256 lt = _mm256_cmp_ps(err, bestV, _CMP_LT_OQ);
+        bestV = _mm256_blendv_ps(bestV, err, lt);
+        bestI = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(bestI), _mm256_castsi256_ps(idx), lt));
+        idx = _mm256_add_epi32(idx, step);
+    }
+
+    float best[8U];
+    int32_t index[8U];
+    _mm256_storeu_ps(best, bestV);
+    _mm256_storeu_si256((__m256i*)index, bestI);
+    return reduceLanes(best, index, 8U);
+#elif defined(VQ_SIMD_SSE2)
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 t = _mm_set1_ps(target);
+
+    __m128 bestV = _mm_set1_ps(HUGE_VALF);
+    __m128i bestI = _mm_setr_epi32(0, 1, 2, 3);
+    __m128i idx = bestI;
+    const __m128i step = _mm_set1_epi32(4);
+
+    for (uint32_t i = 0U; i < m_padded; i += 4U) {
+        __m128 err = _mm_and_ps(_mm_sub_ps(t, _mm_loadu_ps(m_data + i)), absMask);
+
+        __m128 lt = _mm_cmplt_ps(err, bestV);
+        __m128i ltI = _mm_castps_si128(lt);
+        bestV = _mm_or_ps(_mm_and_ps(lt, err), _mm_andnot_ps(lt, bestV));
+        bestI = _mm_or_si128(_mm_and_si128(ltI, idx), _mm_andnot_si128(ltI, bestI));
+        idx = _mm_add_epi32(idx, step);
+    }
+
+    float best[4U];
+    int32_t index[4U];
+    _mm_storeu_ps(best, bestV);
+    _mm_storeu_si128((__m128i*)index, bestI);
+    return reduceLanes(best, index, 4U);
+#elif defined(VQ_SIMD_NEON)
+    static const int32_t LANES[4U] = { 0, 1, 2, 3 };
+
+    const float32x4_t t = vdupq_n_f32(target);
+
+    float32x4_t bestV = vdupq_n_f32(HUGE_VALF);
+    int32x4_t bestI = vld1q_s32(LANES);
+    int32x4_t idx = bestI;
+    const int32x4_t step = vdupq_n_s32(4);
+
+    for (uint32_t i = 0U; i < m_padded; i += 4U) {
+        float32x4_t err = vabsq_f32(vsubq_f32(t, vld1q_f32(m_data + i)));
+
+        uint32x4_t lt = vcltq_f32(err, bestV);
+        bestV = vbslq_f32(lt, err, bestV);
+        bestI = vbslq_s32(lt, idx, bestI);
+        idx = vaddq_s32(idx, step);
+    }
+
+    float best[4U];
+    int32_t index[4U];
+    vst1q_f32(best, bestV);
+    vst1q_s32(index, bestI);
+    return reduceLanes(best, index, 4U);
+#else
+    return searchAbsScalar(target);
+#endif
+}
+
+/// <summary>
+/// Finds the entry with the least squared error to the target, without vector instructions.
+/// </summary>
+/// <param name="target">Target vector.</param>
+/// <param name="dims">Number of leading components to compare.</param>
+/// <returns>Index of the nearest entry.</returns>
+uint32_t VQCodebook::searchScalar(const float* target, uint32_t dims) const
+{
+    assert(dims <= m_dims);
+
+    float error = 0.0f;
+    uint32_t index = 0U;
+    for (uint32_t i = 0U; i < m_count; i++) {
+        float err = 0.0f;
+        for (uint32_t d = 0U; d < dims; d++) {
+            float diff = target[d] - m_data[d * m_padded + i];
+            err += (diff * diff);
+        }
+
+        if (i == 0U || err < error) {
+            error = err;
+            index = i;
+        }
+    }
+
+    return index;
+}
+
+/// <summary>
+/// Finds the entry with the least absolute error to the target, without vector instructions.
+/// </summary>
+/// <param name="target">Target value.</param>
+/// <returns>Index of the nearest entry.</returns>
+uint32_t VQCodebook::searchAbsScalar(float target) const
+{
+    float error = 0.0f;
+    uint32_t index = 0U;
+    for (uint32_t i = 0U; i < m_count; i++) {
+        float err = fabsf(target - m_data[i]);
+        if (i == 0U || err < error) {
+            error = err;
+            index = i;
+        }
+    }
+
+    return index;
+}
+
+/// <summary>
+/// Adds the value to every accumulator whose mask is set.
+/// </summary>
+/// <remarks>Masks are all ones or all zeros; count must be a multiple of VQ_LANES.</remarks>
+/// <param name="acc">Accumulators.</param>
+/// <param name="mask">Per-accumulator masks.</param>
+/// <param name="value">Value to add.</param>
+/// <param name="count">Number of accumulators.</param>
+void VQCodebook::accumulate(float* acc, const uint32_t* mask, float value, uint32_t count)
+{
+    assert((count % VQ_LANES) == 0U);
+
+#if defined(VQ_SIMD_AVX2)
+    const __m256 v = _mm256_set1_ps(value);
+    for (uint32_t i = 0U; i < count; i += 8U) {
+        __m256 m = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)(mask + i)));
+        _mm256_storeu_ps(acc + i, _mm256_add_ps(_mm256_loadu_ps(acc + i), _mm256_and_ps(v, m)));
+    }
+#elif defined(VQ_SIMD_SSE2)
+    const __m128 v = _mm_set1_ps(value);
+    for (uint32_t i = 0U; i < count; i += 4U) {
+        __m128 m = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(mask + i)));
+        _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_and_ps(v, m)));
+    }
+#elif defined(VQ_SIMD_NEON)
+    const float32x4_t v = vdupq_n_f32(value);
+    for (uint32_t i = 0U; i < count; i += 4U) {
+        float32x4_t m = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(v), vld1q_u32(mask + i)));
+        vst1q_f32(acc + i, vaddq_f32(vld1q_f32(acc + i), m));
+    }
+#else
+    for (uint32_t i = 0U; i < count; i++) {
+        if (mask[i] != 0U)
+            acc[i] += value;
+    }
+#endif
+}
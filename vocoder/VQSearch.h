@@ -0,0 +1,89 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__VQ_SEARCH_H__)
+#define __VQ_SEARCH_H__
+
+#include "Defines.h"
+
+#if defined(__AVX2__)
+#define VQ_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+#define VQ_SIMD_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+// 32-bit NEON flushes denormals to zero and would not match the scalar search
+#define VQ_SIMD_NEON
+#endif
+
+namespace vocoder
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t VQ_LANES = 8U;   // entries are padded to a multiple of the widest vector
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Implements a vector quantizer codebook laid out as structure-of-arrays
+    //      (one row per vector component, padded to VQ_LANES entries) and its
+    //      nearest-neighbour search. The vector and scalar searches evaluate the
+    //      same expressions in the same order, so they return the same index;
+    //      ties go to the lowest index.
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API VQCodebook {
+    public:
+        /// <summary>Initializes a new instance of the VQCodebook class.</summary>
+        VQCodebook(const float* table, uint32_t count, uint32_t dims);
+        /// <summary>Finalizes a instance of the VQCodebook class.</summary>
+        ~VQCodebook();
+
+        /// <summary>Finds the entry with the least squared error to the target over the first components.</summary>
+        uint32_t search(const float* target, uint32_t dims) const;
+        /// <summary>Finds the entry with the least absolute error to the target.</summary>
+        uint32_t searchAbs(float target) const;
+
+        /// <summary>Finds the entry with the least squared error to the target, without vector instructions.</summary>
+        uint32_t searchScalar(const float* target, uint32_t dims) const;
+        /// <summary>Finds the entry with the least absolute error to the target, without vector instructions.</summary>
+        uint32_t searchAbsScalar(float target) const;
+
+        /// <summary>Adds the value to every accumulator whose mask is set.</summary>
+        static void accumulate(float* acc, const uint32_t* mask, float value, uint32_t count);
+
+        /// <summary>Gets the number of entries in the codebook.</summary>
+        uint32_t getCount() const { return m_count; }
+
+    private:
+        uint32_t m_count;
+        uint32_t m_padded;
+        uint32_t m_dims;
+
+        float* m_data;
+    };
+} // namespace vocoder
+
+#endif // __VQ_SEARCH_H__
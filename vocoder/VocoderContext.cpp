@@ -0,0 +1,361 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "dmr/DMRDefines.h"
+#include "p25/P25Defines.h"
+#include "vocoder/VocoderContext.h"
+#include "Log.h"
+
+using namespace vocoder;
+
+#include <cmath>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+// decoded frames with less energy than this (sum of squares over the 160 samples,
+// an RMS of 4 or about -78 dBFS) are treated as silence and not re-encoded
+const int64_t SILENCE_ENERGY_THRESHOLD = 160 * 4 * 4;
+
+// silence only takes the fast path once this many silent frames in a row have run
+// through the full transcode; by then the 621 sample speech analysis buffer of the
+// encoder holds no speech from before the pause
+const uint32_t SILENCE_HOLDOFF_FRAMES = 4U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/// <summary>
+/// Helper to get the model parameters fed to the encoders while they sit out a pause.
+/// </summary>
+/// <remarks>Every harmonic is unvoiced and at zero amplitude, which quantizes to the smallest spectral
+/// amplitudes the encoders can represent. The shortest pitch period keeps the harmonic count, and
+/// with it the cost of quantizing, low.</remarks>
+static const mbe_parms& silenceParms()
+{
+    struct SilenceParms {
+        mbe_parms parms;
+
+        SilenceParms()
+        {
+            ::memset(&parms, 0x00U, sizeof(mbe_parms));
+            parms.w0 = (float)(2.0 * M_PI / 20.0);
+            parms.L = 9;
+        }
+    };
+
+    static const SilenceParms silence;
+    return silence.parms;
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+/// <summary>
+/// Initializes a new instance of the VocoderContext class.
+/// </summary>
+/// <param name="decodeMode">Mode of the MBE decoder.</param>
+/// <param name="encodeMode">Mode of the MBE encoder.</param>
+/// <param name="gainAdjust">Gain adjustment applied by the MBE encoder.</param>
+/// <param name="mode">Transcode mode.</param>
+/// <param name="compare">Flag indicating the other transcode mode should be run alongside for an A/B comparison.</param>
+/// <param name="floatFFT">Flag indicating the MBE encoder should run its analysis FFT in floating point.</param>
+VocoderContext::VocoderContext(MBE_DECODER_MODE decodeMode, MBE_ENCODER_MODE encodeMode, float gainAdjust, TRANSCODE_MODE mode, bool compare, bool floatFFT) :
+    m_decoder(nullptr),
+    m_encoder(nullptr),
+    m_mode(mode),
+    m_inputLength((decodeMode == DECODE_DMR_AMBE) ? 9U : 11U),
+    m_outputLength((encodeMode == ENCODE_DMR_AMBE) ? 9U : 11U),
+    m_silenceInput((decodeMode == DECODE_DMR_AMBE) ? dmr::DMR_SILENCE_AMBE : p25::P25_NULL_IMBE),
+    m_silentFrames(0U),
+    m_altDecoder(nullptr),
+    m_altEncoder(nullptr),
+    m_pcmListener(nullptr),
+    m_parmListener(nullptr),
+    m_cmpFrames(0U),
+    m_cmpMatched(0U),
+    m_cmpVoiced(0U),
+    m_cmpHarms(0U),
+    m_cmpVuvDiff(0U),
+    m_cmpPitchErr(0.0),
+    m_cmpLSD(0.0),
+    m_cmpBias(0.0)
+{
+    m_decoder = new MBEDecoder(decodeMode);
+    m_encoder = new MBEEncoder(encodeMode, floatFFT);
+    m_encoder->setGainAdjust(gainAdjust);
+
+    if (compare) {
+        MBE_DECODER_MODE listenMode = (encodeMode == ENCODE_DMR_AMBE) ? DECODE_DMR_AMBE : DECODE_88BIT_IMBE;
+
+        m_altDecoder = new MBEDecoder(decodeMode);
+        m_altEncoder = new MBEEncoder(encodeMode, floatFFT);
+        m_altEncoder->setGainAdjust(gainAdjust);
+        m_pcmListener = new MBEDecoder(listenMode);
+        m_parmListener = new MBEDecoder(listenMode);
+    }
+}
+
+/// <summary>
+/// Finalizes a instance of the VocoderContext class.
+/// </summary>
+VocoderContext::~VocoderContext()
+{
+    delete m_parmListener;
+    delete m_pcmListener;
+    delete m_altEncoder;
+    delete m_altDecoder;
+
+    delete m_encoder;
+    delete m_decoder;
+}
+
+/// <summary>
+/// Transcodes a single MBE codeword using the transcode mode.
+/// </summary>
+/// <param name="codeword">MBE codeword in the decoder mode.</param>
+/// <param name="output">Buffer receiving the MBE codeword in the encoder mode.</param>
+/// <returns>Number of errors corrected in the input codeword.</returns>
+int32_t VocoderContext::transcode(uint8_t* codeword, uint8_t* output)
+{
+    // once the holdoff has flushed the speech before the pause, silence skips speech
+    // synthesis and analysis; the encoders quantize fixed silence parameters instead, and
+    // the codeword they produce is the one sent, so the far end's prediction history stays
+    // in step with theirs
+    bool idle = m_silentFrames >= SILENCE_HOLDOFF_FRAMES;
+
+    // known silence needs no decoding to recognize
+    bool silent = ::memcmp(codeword, m_silenceInput, m_inputLength) == 0;
+    if (silent && idle) {
+        mbe_parms parms;
+        int32_t errs = m_decoder->decodeParms(codeword, &parms);
+        m_encoder->encodeParms(&silenceParms(), output);
+
+        if (m_altDecoder != nullptr) {
+            uint8_t altOutput[11U];
+            m_altDecoder->decodeParms(codeword, &parms);
+            m_altEncoder->encodeParms(&silenceParms(), altOutput);
+
+            // the listeners stand in for the far end, which receives whatever either chain quantized
+            uint8_t buffer[11U];
+            ::memcpy(buffer, (m_mode == TRANSCODE_PCM) ? output : altOutput, m_outputLength);
+            m_pcmListener->decodeParms(buffer, &parms);
+            ::memcpy(buffer, (m_mode == TRANSCODE_PCM) ? altOutput : output, m_outputLength);
+            m_parmListener->decodeParms(buffer, &parms);
+        }
+
+        return errs;
+    }
+
+    bool quiet = false;
+    int32_t errs = transcode(m_mode, m_decoder, m_encoder, codeword, output, &quiet, idle);
+    if (silent || quiet) {
+        if (m_silentFrames < SILENCE_HOLDOFF_FRAMES) {
+            m_silentFrames++;
+        }
+    }
+    else {
+        m_silentFrames = 0U;
+    }
+
+    if (m_altDecoder != nullptr) {
+        compare(codeword, output);
+    }
+
+    return errs;
+}
+
+/// <summary>
+/// Helper to report and reset the A/B comparison at the end of a call.
+/// </summary>
+void VocoderContext::finishCall()
+{
+    if (m_altDecoder == nullptr || m_cmpFrames == 0U)
+        return;
+
+    // the PCM path is the reference; spectral distances are of the parametric path's amplitudes
+    if (m_cmpVoiced > 0U && m_cmpHarms > 0U) {
+        LogMessage(LOG_HOST, "Vocoder A/B, %u frames, %u identical, %u voice, pitch error %.2f%%, log spectral distance %.2f dB, level bias %.2f dB, v/uv mismatch %.2f%%",
+            m_cmpFrames, m_cmpMatched, m_cmpVoiced, (m_cmpPitchErr / m_cmpVoiced) * 100.0, m_cmpLSD / m_cmpVoiced, m_cmpBias / m_cmpVoiced,
+            ((double)m_cmpVuvDiff / m_cmpHarms) * 100.0);
+    }
+    else {
+        LogMessage(LOG_HOST, "Vocoder A/B, %u frames, %u identical, no voice frames to compare", m_cmpFrames, m_cmpMatched);
+    }
+
+    m_cmpFrames = 0U;
+    m_cmpMatched = 0U;
+    m_cmpVoiced = 0U;
+    m_cmpHarms = 0U;
+    m_cmpVuvDiff = 0U;
+    m_cmpPitchErr = 0.0;
+    m_cmpLSD = 0.0;
+    m_cmpBias = 0.0;
+}
+
+/// <summary>
+/// Returns the decoders and encoders to their initial state for a new call.
+/// </summary>
+/// <remarks>The A/B comparison totals are left alone; they are reported and cleared by finishCall().</remarks>
+void VocoderContext::reset()
+{
+    m_silentFrames = 0U;
+
+    m_decoder->reset();
+    m_encoder->reset();
+
+    if (m_altDecoder != nullptr) {
+        m_altDecoder->reset();
+        m_altEncoder->reset();
+        m_pcmListener->reset();
+        m_parmListener->reset();
+    }
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+/// <summary>
+/// Helper to transcode a single MBE codeword with the given decoder and encoder.
+/// </summary>
+/// <param name="mode">Transcode mode.</param>
+/// <param name="decoder">MBE decoder.</param>
+/// <param name="encoder">MBE encoder.</param>
+/// <param name="codeword">MBE codeword in the decoder mode.</param>
+/// <param name="output">Buffer receiving the MBE codeword in the encoder mode.</param>
+/// <param name="silent">If not null, set when the frame decodes to silence.</param>
+/// <param name="idle">Flag indicating frames that decode to silence skip speech analysis and are encoded
+/// from the silence parameters.</param>
+/// <returns>Number of errors corrected in the input codeword.</returns>
+int32_t VocoderContext::transcode(TRANSCODE_MODE mode, MBEDecoder* decoder, MBEEncoder* encoder, uint8_t* codeword, uint8_t* output, bool* silent, bool idle)
+{
+    int32_t errs = 0;
+    if (mode == TRANSCODE_PARAMETRIC) {
+        mbe_parms parms;
+        errs = decoder->decodeParms(codeword, &parms);
+
+        if (silent != nullptr) {
+            // each harmonic is synthesized with amplitude Ml, contributing Ml^2 / 2 per sample
+            double energy = 0.0;
+            for (int l = 1; l <= parms.L; l++) {
+                energy += parms.Ml[l] * parms.Ml[l];
+            }
+
+            if (energy * 80.0 < SILENCE_ENERGY_THRESHOLD) {
+                *silent = true;
+                if (idle) {
+                    encoder->encodeParms(&silenceParms(), output);
+                    return errs;
+                }
+            }
+        }
+
+        encoder->encodeParms(&parms, output);
+    }
+    else {
+        int16_t pcmSamples[160U];
+        ::memset(pcmSamples, 0x00U, sizeof(pcmSamples));
+
+        errs = decoder->decode(codeword, pcmSamples);
+
+        if (silent != nullptr) {
+            int64_t energy = 0;
+            for (uint32_t i = 0U; i < 160U; i++) {
+                energy += (int32_t)pcmSamples[i] * pcmSamples[i];
+            }
+
+            if (energy < SILENCE_ENERGY_THRESHOLD) {
+                *silent = true;
+                if (idle) {
+                    encoder->encodeParms(&silenceParms(), output);
+                    return errs;
+                }
+            }
+        }
+
+        encoder->encode(pcmSamples, output);
+    }
+
+    return errs;
+}
+
+/// <summary>
+/// Helper to run the alternate transcode mode and accumulate the A/B comparison.
+/// </summary>
+/// <param name="codeword">MBE codeword in the decoder mode.</param>
+/// <param name="output">MBE codeword produced by the transcode mode.</param>
+void VocoderContext::compare(uint8_t* codeword, const uint8_t* output)
+{
+    uint8_t altOutput[11U];
+    ::memset(altOutput, 0x00U, sizeof(altOutput));
+
+    TRANSCODE_MODE altMode = (m_mode == TRANSCODE_PCM) ? TRANSCODE_PARAMETRIC : TRANSCODE_PCM;
+    transcode(altMode, m_altDecoder, m_altEncoder, codeword, altOutput);
+
+    const uint8_t* pcmOutput = (m_mode == TRANSCODE_PCM) ? output : altOutput;
+    const uint8_t* parmOutput = (m_mode == TRANSCODE_PCM) ? altOutput : output;
+
+    if (::memcmp(pcmOutput, parmOutput, m_outputLength) == 0) {
+        m_cmpMatched++;
+    }
+
+    m_cmpFrames++;
+
+    // decode what the far end would receive from either path
+    uint8_t buffer[11U];
+    mbe_parms ref, parms;
+
+    ::memcpy(buffer, pcmOutput, m_outputLength);
+    m_pcmListener->decodeParms(buffer, &ref);
+    ::memcpy(buffer, parmOutput, m_outputLength);
+    m_parmListener->decodeParms(buffer, &parms);
+
+    if (ref.L <= 0 || parms.L <= 0)
+        return;
+
+    int L = (ref.L < parms.L) ? ref.L : parms.L;
+    double sum = 0.0, sumSq = 0.0;
+    for (int l = 1; l <= L; l++) {
+        double refMl = (ref.Ml[l] > 1e-3f) ? ref.Ml[l] : 1e-3;
+        double Ml = (parms.Ml[l] > 1e-3f) ? parms.Ml[l] : 1e-3;
+        double d = 20.0 * std::log10(Ml / refMl);
+        sum += d;
+        sumSq += d * d;
+
+        if (ref.Vl[l] != parms.Vl[l]) {
+            m_cmpVuvDiff++;
+        }
+    }
+
+    m_cmpVoiced++;
+    m_cmpHarms += L;
+    m_cmpPitchErr += std::fabs(parms.w0 - ref.w0) / ref.w0;
+    m_cmpLSD += std::sqrt(sumSq / L);
+    m_cmpBias += sum / L;
+}
@@ -0,0 +1,107 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__VOCODER_CONTEXT_H__)
+#define __VOCODER_CONTEXT_H__
+
+#include "Defines.h"
+#include "vocoder/MBEDecoder.h"
+#include "vocoder/MBEEncoder.h"
+
+namespace vocoder
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    enum TRANSCODE_MODE {
+        TRANSCODE_PCM,          // synthesize PCM and re-analyze it with the encoder
+        TRANSCODE_PARAMETRIC    // map decoded model parameters straight to the encoder's quantizer
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Implements the vocoder state for a single transcode direction (one
+    //      decoder feeding one encoder). A context holds the synthesis and
+    //      analysis history of exactly one call stream and must only be used by
+    //      one thread at a time.
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API VocoderContext {
+    public:
+        /// <summary>Initializes a new instance of the VocoderContext class.</summary>
+        VocoderContext(MBE_DECODER_MODE decodeMode, MBE_ENCODER_MODE encodeMode, float gainAdjust, TRANSCODE_MODE mode = TRANSCODE_PCM, bool compare = false, bool floatFFT = false);
+        /// <summary>Finalizes a instance of the VocoderContext class.</summary>
+        ~VocoderContext();
+
+        /// <summary>Transcodes a single MBE codeword using the transcode mode.</summary>
+        int32_t transcode(uint8_t* codeword, uint8_t* output);
+        /// <summary>Helper to report and reset the A/B comparison at the end of a call.</summary>
+        void finishCall();
+        /// <summary>Returns the decoders and encoders to their initial state for a new call.</summary>
+        void reset();
+
+        /// <summary>Gets the MBE decoder for this context.</summary>
+        MBEDecoder* decoder() const { return m_decoder; }
+        /// <summary>Gets the MBE encoder for this context.</summary>
+        MBEEncoder* encoder() const { return m_encoder; }
+
+    private:
+        MBEDecoder* m_decoder;
+        MBEEncoder* m_encoder;
+
+        TRANSCODE_MODE m_mode;
+        uint32_t m_inputLength;
+        uint32_t m_outputLength;
+
+        // silence fast path; after a run of silent frames, frames that are (or decode to)
+        // silence are encoded from fixed silence parameters without speech analysis
+        const uint8_t* m_silenceInput;
+        uint32_t m_silentFrames;
+
+        // A/B comparison; the alternate chain runs the other transcode mode and the
+        // listeners decode the model parameters both outputs carry to the far end
+        MBEDecoder* m_altDecoder;
+        MBEEncoder* m_altEncoder;
+        MBEDecoder* m_pcmListener;
+        MBEDecoder* m_parmListener;
+
+        uint32_t m_cmpFrames;
+        uint32_t m_cmpMatched;
+        uint32_t m_cmpVoiced;
+        uint32_t m_cmpHarms;
+        uint32_t m_cmpVuvDiff;
+        double m_cmpPitchErr;
+        double m_cmpLSD;
+        double m_cmpBias;
+
+        /// <summary>Helper to transcode a single MBE codeword with the given decoder and encoder.</summary>
+        int32_t transcode(TRANSCODE_MODE mode, MBEDecoder* decoder, MBEEncoder* encoder, uint8_t* codeword, uint8_t* output, bool* silent = nullptr, bool idle = false);
+        /// <summary>Helper to run the alternate transcode mode and accumulate the A/B comparison.</summary>
+        void compare(uint8_t* codeword, const uint8_t* output);
+    };
+} // namespace vocoder
+
+#endif // __VOCODER_CONTEXT_H__
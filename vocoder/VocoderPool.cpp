@@ -0,0 +1,318 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#include "Defines.h"
+#include "vocoder/VocoderPool.h"
+#include "Log.h"
+
+using namespace vocoder;
+
+#include <cassert>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+/// <summary>
+/// Initializes a new instance of the VocoderChannel class.
+/// </summary>
+/// <param name="pool">Instance of the VocoderPool class, or nullptr to process jobs inline.</param>
+VocoderChannel::VocoderChannel(VocoderPool* pool) :
+    m_worker(nullptr),
+    m_mutex(),
+    m_completedHead(nullptr),
+    m_completedTail(nullptr),
+    m_pending(0U)
+{
+    if (pool != nullptr) {
+        m_worker = pool->assign();
+    }
+}
+
+/// <summary>
+/// Finalizes a instance of the VocoderChannel class.
+/// </summary>
+VocoderChannel::~VocoderChannel()
+{
+    // the worker may still hold references to this channel; wait for it to
+    // hand everything back before the owner releases the jobs
+    while (m_pending.load() > 0U) {
+        if (getCompleted() != nullptr)
+            continue;
+
+        Thread::sleep(1U);
+    }
+}
+
+/// <summary>
+/// Submits a job to the worker this channel is pinned to.
+/// </summary>
+/// <remarks>The job stays owned by the caller, but must not be touched or reused until it
+/// is returned by getCompleted().</remarks>
+/// <param name="job"></param>
+void VocoderChannel::submit(VocoderJob* job)
+{
+    assert(job != nullptr);
+
+    job->m_channel = this;
+    job->m_next = nullptr;
+    m_pending++;
+
+    if (m_worker == nullptr) {
+        job->process();
+        complete(job);
+        return;
+    }
+
+    m_worker->post(job);
+}
+
+/// <summary>
+/// Gets the next completed job, in submission order.
+/// </summary>
+/// <remarks>The returned job may be reused by the caller.</remarks>
+/// <returns>Completed job, or nullptr if no jobs have completed.</returns>
+VocoderJob* VocoderChannel::getCompleted()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_completedHead == nullptr)
+        return nullptr;
+
+    VocoderJob* job = m_completedHead;
+    m_completedHead = job->m_next;
+    if (m_completedHead == nullptr) {
+        m_completedTail = nullptr;
+    }
+
+    job->m_next = nullptr;
+    m_pending--;
+
+    return job;
+}
+
+/// <summary>
+/// Initializes a new instance of the VocoderWorker class.
+/// </summary>
+/// <param name="id">Worker ID.</param>
+/// <param name="pool">Instance of the VocoderPool class that owns this worker.</param>
+VocoderWorker::VocoderWorker(uint32_t id, VocoderPool* pool) : Thread(),
+    m_id(id),
+    m_pool(pool),
+    m_mutex(),
+    m_cond(),
+    m_queueHead(nullptr),
+    m_queueTail(nullptr),
+    m_killed(false)
+{
+    /* stub */
+}
+
+/// <summary>
+/// Finalizes a instance of the VocoderWorker class.
+/// </summary>
+VocoderWorker::~VocoderWorker()
+{
+    /* stub */
+}
+
+/// <summary>
+/// Adds a job to the end of the worker queue.
+/// </summary>
+/// <param name="job"></param>
+void VocoderWorker::post(VocoderJob* job)
+{
+    assert(job != nullptr);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_queueTail != nullptr) {
+            m_queueTail->m_next = job;
+        }
+        else {
+            m_queueHead = job;
+        }
+
+        m_queueTail = job;
+    }
+
+    m_cond.notify_one();
+}
+
+/// <summary>
+/// Signals the worker to stop once its queue is empty.
+/// </summary>
+void VocoderWorker::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_killed = true;
+    }
+
+    m_cond.notify_one();
+}
+
+/// <summary>
+/// User-defined function to run for the thread main.
+/// </summary>
+void VocoderWorker::entry()
+{
+    while (true) {
+        VocoderJob* job = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (m_queueHead == nullptr && !m_killed)
+                m_cond.wait(lock);
+
+            if (m_queueHead == nullptr)
+                break;
+
+            job = m_queueHead;
+            m_queueHead = job->m_next;
+            if (m_queueHead == nullptr) {
+                m_queueTail = nullptr;
+            }
+        }
+
+        job->m_next = nullptr;
+
+        job->process();
+        job->m_channel->complete(job);
+
+        m_pool->notify();
+    }
+}
+
+/// <summary>
+/// Initializes a new instance of the VocoderPool class.
+/// </summary>
+/// <param name="workers">Number of worker threads; zero processes all vocoder work on the host thread.</param>
+VocoderPool::VocoderPool(uint32_t workers) :
+    m_workers(),
+    m_next(0U),
+    m_running(false),
+    m_reactor(nullptr)
+{
+    for (uint32_t i = 0U; i < workers; i++) {
+        m_workers.push_back(new VocoderWorker(i, this));
+    }
+}
+
+/// <summary>
+/// Finalizes a instance of the VocoderPool class.
+/// </summary>
+VocoderPool::~VocoderPool()
+{
+    stop();
+
+    for (VocoderWorker* worker : m_workers) {
+        delete worker;
+    }
+
+    m_workers.clear();
+}
+
+/// <summary>
+/// Starts the worker threads.
+/// </summary>
+/// <returns>True, if the worker threads were started, otherwise false.</returns>
+bool VocoderPool::start()
+{
+    if (m_running)
+        return true;
+
+    for (VocoderWorker* worker : m_workers) {
+        if (!worker->run()) {
+            LogError(LOG_HOST, "failed to start vocoder worker %u", worker->getId());
+            return false;
+        }
+    }
+
+    m_running = true;
+    return true;
+}
+
+/// <summary>
+/// Stops and joins the worker threads.
+/// </summary>
+void VocoderPool::stop()
+{
+    if (!m_running)
+        return;
+
+    for (VocoderWorker* worker : m_workers) {
+        worker->stop();
+    }
+
+    for (VocoderWorker* worker : m_workers) {
+        worker->wait();
+    }
+
+    m_running = false;
+}
+
+/// <summary>
+/// Assigns a worker to a new channel.
+/// </summary>
+/// <returns>Worker the channel is pinned to, or nullptr if the pool has no workers.</returns>
+VocoderWorker* VocoderPool::assign()
+{
+    if (m_workers.empty())
+        return nullptr;
+
+    VocoderWorker* worker = m_workers[m_next];
+    m_next = (m_next + 1U) % m_workers.size();
+
+    return worker;
+}
+
+/// <summary>
+/// Signals the host loop that a job has completed.
+/// </summary>
+void VocoderPool::notify()
+{
+    if (m_reactor != nullptr) {
+        m_reactor->wake();
+    }
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+/// <summary>
+/// Internal helper to hand a processed job back to the channel.
+/// </summary>
+/// <param name="job"></param>
+void VocoderChannel::complete(VocoderJob* job)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_completedTail != nullptr) {
+        m_completedTail->m_next = job;
+    }
+    else {
+        m_completedHead = job;
+    }
+
+    m_completedTail = job;
+}
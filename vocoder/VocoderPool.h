@@ -0,0 +1,183 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#if !defined(__VOCODER_POOL_H__)
+#define __VOCODER_POOL_H__
+
+#include "Defines.h"
+#include "Reactor.h"
+#include "Thread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace vocoder
+{
+    // ---------------------------------------------------------------------------
+    //  Class Prototypes
+    // ---------------------------------------------------------------------------
+    class HOST_SW_API VocoderChannel;
+    class HOST_SW_API VocoderWorker;
+    class HOST_SW_API VocoderPool;
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Represents a single unit of vocoder work. process() is executed on the
+    //      worker thread the owning channel is pinned to; the job is then handed
+    //      back to the owning channel for completion on the host thread.
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API VocoderJob {
+    public:
+        /// <summary>Initializes a new instance of the VocoderJob class.</summary>
+        VocoderJob() : m_channel(nullptr), m_next(nullptr) { /* stub */ }
+        /// <summary>Finalizes a instance of the VocoderJob class.</summary>
+        virtual ~VocoderJob() { /* stub */ }
+
+        /// <summary>Performs the vocoder work for this job.</summary>
+        virtual void process() = 0;
+
+    private:
+        friend class VocoderChannel;
+        friend class VocoderWorker;
+
+        VocoderChannel* m_channel;
+        VocoderJob* m_next;
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Implements a per-call channel into the vocoder pool. Every job submitted
+    //      through a channel runs on the same worker, in submission order, so the
+    //      vocoder state behind the channel is only ever touched by one thread.
+    //      Jobs are chained through the job itself, so submitting and completing
+    //      work never allocates.
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API VocoderChannel {
+    public:
+        /// <summary>Initializes a new instance of the VocoderChannel class.</summary>
+        VocoderChannel(VocoderPool* pool);
+        /// <summary>Finalizes a instance of the VocoderChannel class.</summary>
+        ~VocoderChannel();
+
+        /// <summary>Submits a job to the worker this channel is pinned to.</summary>
+        void submit(VocoderJob* job);
+
+        /// <summary>Gets the next completed job, in submission order.</summary>
+        VocoderJob* getCompleted();
+
+        /// <summary>Helper to return whether the channel has jobs that have not been returned yet.</summary>
+        bool isBusy() const { return m_pending.load() > 0U; }
+
+    private:
+        friend class VocoderWorker;
+
+        VocoderWorker* m_worker;
+
+        std::mutex m_mutex;
+        VocoderJob* m_completedHead;
+        VocoderJob* m_completedTail;
+        std::atomic<uint32_t> m_pending;
+
+        /// <summary>Internal helper to hand a processed job back to the channel.</summary>
+        void complete(VocoderJob* job);
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Implements a vocoder worker thread.
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API VocoderWorker : public Thread {
+    public:
+        /// <summary>Initializes a new instance of the VocoderWorker class.</summary>
+        VocoderWorker(uint32_t id, VocoderPool* pool);
+        /// <summary>Finalizes a instance of the VocoderWorker class.</summary>
+        ~VocoderWorker();
+
+        /// <summary>Adds a job to the end of the worker queue.</summary>
+        void post(VocoderJob* job);
+
+        /// <summary>Signals the worker to stop once its queue is empty.</summary>
+        void stop();
+
+        /// <summary>User-defined function to run for the thread main.</summary>
+        void entry();
+
+        /// <summary>Gets the worker ID.</summary>
+        uint32_t getId() const { return m_id; }
+
+    private:
+        uint32_t m_id;
+        VocoderPool* m_pool;
+
+        std::mutex m_mutex;
+        std::condition_variable m_cond;
+        VocoderJob* m_queueHead;
+        VocoderJob* m_queueTail;
+        bool m_killed;
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    //      Implements a fixed-size pool of vocoder worker threads.
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API VocoderPool {
+    public:
+        /// <summary>Initializes a new instance of the VocoderPool class.</summary>
+        VocoderPool(uint32_t workers);
+        /// <summary>Finalizes a instance of the VocoderPool class.</summary>
+        ~VocoderPool();
+
+        /// <summary>Starts the worker threads.</summary>
+        bool start();
+        /// <summary>Stops and joins the worker threads.</summary>
+        void stop();
+
+        /// <summary>Assigns a worker to a new channel.</summary>
+        VocoderWorker* assign();
+
+        /// <summary>Sets the reactor woken when a job completes.</summary>
+        void setReactor(Reactor* reactor) { m_reactor = reactor; }
+        /// <summary>Signals the host loop that a job has completed.</summary>
+        void notify();
+
+        /// <summary>Gets the number of worker threads in the pool.</summary>
+        uint32_t getWorkerCount() const { return (uint32_t)m_workers.size(); }
+
+    private:
+        std::vector<VocoderWorker*> m_workers;
+        uint32_t m_next;
+        bool m_running;
+
+        Reactor* m_reactor;
+    };
+} // namespace vocoder
+
+#endif // __VOCODER_POOL_H__
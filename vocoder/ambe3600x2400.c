@@ -591,7 +591,8 @@ void mbe_demodulateAmbe3600x2400Data(char ambe_fr[4][24])
 /// <param name="prev_mp"></param>
 /// <param name="prev_mp_enhanced"></param>
 /// <param name="uvquality"></param>
-void mbe_processAmbe2400DataF(float* aout_buf, int* errs, int* errs2, char* err_str, char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality)
+/// <param name="state"></param>
+void mbe_processAmbe2400DataF(float* aout_buf, int* errs, int* errs2, char* err_str, char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality, mbe_state* state)
 {
     int i, bad;
 
@@ -627,7 +628,7 @@ void mbe_processAmbe2400DataF(float* aout_buf, int* errs, int* errs2, char* err_
         if (cur_mp->repeat <= 3) {
             mbe_moveMbeParms(cur_mp, prev_mp);
             mbe_spectralAmpEnhance(cur_mp);
-            mbe_synthesizeSpeechf(aout_buf, cur_mp, prev_mp_enhanced, uvquality);
+            mbe_synthesizeSpeechf(aout_buf, cur_mp, prev_mp_enhanced, uvquality, state);
             mbe_moveMbeParms(cur_mp, prev_mp_enhanced);
         }
         else {
@@ -657,10 +658,11 @@ void mbe_processAmbe2400DataF(float* aout_buf, int* errs, int* errs2, char* err_
 /// <param name="prev_mp"></param>
 /// <param name="prev_mp_enhanced"></param>
 /// <param name="uvquality"></param>
-void mbe_processAmbe2400Data(short* aout_buf, int* errs, int* errs2, char* err_str, char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality)
+/// <param name="state"></param>
+void mbe_processAmbe2400Data(short* aout_buf, int* errs, int* errs2, char* err_str, char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality, mbe_state* state)
 {
     float float_buf[160];
-    mbe_processAmbe2400DataF(float_buf, errs, errs2, err_str, ambe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality);
+    mbe_processAmbe2400DataF(float_buf, errs, errs2, err_str, ambe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality, state);
     mbe_floatToShort(float_buf, aout_buf);
 }
 
@@ -677,7 +679,8 @@ void mbe_processAmbe2400Data(short* aout_buf, int* errs, int* errs2, char* err_s
 /// <param name="prev_mp"></param>
 /// <param name="prev_mp_enhanced"></param>
 /// <param name="uvquality"></param>
-void mbe_processAmbe3600x2400FrameF(float* aout_buf, int* errs, int* errs2, char* err_str, char ambe_fr[4][24], char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality)
+/// <param name="state"></param>
+void mbe_processAmbe3600x2400FrameF(float* aout_buf, int* errs, int* errs2, char* err_str, char ambe_fr[4][24], char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality, mbe_state* state)
 {
     *errs = 0;
     *errs2 = 0;
@@ -687,7 +690,7 @@ void mbe_processAmbe3600x2400FrameF(float* aout_buf, int* errs, int* errs2, char
     *errs2 = *errs;
     *errs2 += mbe_eccAmbe3600x2400Data(ambe_fr, ambe_d);
 
-    mbe_processAmbe2400DataF(aout_buf, errs, errs2, err_str, ambe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality);
+    mbe_processAmbe2400DataF(aout_buf, errs, errs2, err_str, ambe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality, state);
 }
 
 /// <summary>
@@ -703,9 +706,10 @@ void mbe_processAmbe3600x2400FrameF(float* aout_buf, int* errs, int* errs2, char
 /// <param name="prev_mp"></param>
 /// <param name="prev_mp_enhanced"></param>
 /// <param name="uvquality"></param>
-void mbe_processAmbe3600x2400Frame(short* aout_buf, int* errs, int* errs2, char* err_str, char ambe_fr[4][24], char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality)
+/// <param name="state"></param>
+void mbe_processAmbe3600x2400Frame(short* aout_buf, int* errs, int* errs2, char* err_str, char ambe_fr[4][24], char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality, mbe_state* state)
 {
     float float_buf[160];
-    mbe_processAmbe3600x2400FrameF(float_buf, errs, errs2, err_str, ambe_fr, ambe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality);
+    mbe_processAmbe3600x2400FrameF(float_buf, errs, errs2, err_str, ambe_fr, ambe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality, state);
     mbe_floatToShort(float_buf, aout_buf);
 }
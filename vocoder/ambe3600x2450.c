@@ -524,9 +524,10 @@ void mbe_demodulateAmbe3600x2450Data(char ambe_fr[4][24])
 }
 
 /// <summary>
-/// 
+/// Decodes the model parameters of a 2450 bps AMBE frame without synthesizing speech.
 /// </summary>
-/// <param name="aout_buf"></param>
+/// <remarks>On return cur_mp holds the enhanced parameters of the frame; the caller is expected
+/// to move them into prev_mp_enhanced once it has finished with them.</remarks>
 /// <param name="errs"></param>
 /// <param name="errs2"></param>
 /// <param name="err_str"></param>
@@ -534,8 +535,8 @@ void mbe_demodulateAmbe3600x2450Data(char ambe_fr[4][24])
 /// <param name="cur_mp"></param>
 /// <param name="prev_mp"></param>
 /// <param name="prev_mp_enhanced"></param>
-/// <param name="uvquality"></param>
-void mbe_processAmbe2450DataF(float* aout_buf, int* errs, int* errs2, char* err_str, char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality)
+/// <returns>1 if the frame carries speech, or 0 if the frame should be rendered as silence.</returns>
+int mbe_processAmbe2450Parms(int* errs, int* errs2, char* err_str, char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced)
 {
     int i, bad;
 
@@ -571,22 +572,42 @@ void mbe_processAmbe2450DataF(float* aout_buf, int* errs, int* errs2, char* err_
         if (cur_mp->repeat <= 3) {
             mbe_moveMbeParms(cur_mp, prev_mp);
             mbe_spectralAmpEnhance(cur_mp);
-            mbe_synthesizeSpeechf(aout_buf, cur_mp, prev_mp_enhanced, uvquality);
-            mbe_moveMbeParms(cur_mp, prev_mp_enhanced);
+            *err_str = 0;
+            return 1;
         }
         else {
             *err_str = 'M';
             err_str++;
-            mbe_synthesizeSilenceF(aout_buf);
-            mbe_initMbeParms(cur_mp, prev_mp, prev_mp_enhanced);
         }
     }
+
+    mbe_initMbeParms(cur_mp, prev_mp, prev_mp_enhanced);
+    *err_str = 0;
+    return 0;
+}
+
+/// <summary>
+/// 
+/// </summary>
+/// <param name="aout_buf"></param>
+/// <param name="errs"></param>
+/// <param name="errs2"></param>
+/// <param name="err_str"></param>
+/// <param name="ambe_d"></param>
+/// <param name="cur_mp"></param>
+/// <param name="prev_mp"></param>
+/// <param name="prev_mp_enhanced"></param>
+/// <param name="uvquality"></param>
+/// <param name="state"></param>
+void mbe_processAmbe2450DataF(float* aout_buf, int* errs, int* errs2, char* err_str, char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality, mbe_state* state)
+{
+    if (mbe_processAmbe2450Parms(errs, errs2, err_str, ambe_d, cur_mp, prev_mp, prev_mp_enhanced)) {
+        mbe_synthesizeSpeechf(aout_buf, cur_mp, prev_mp_enhanced, uvquality, state);
+        mbe_moveMbeParms(cur_mp, prev_mp_enhanced);
+    }
     else {
         mbe_synthesizeSilenceF(aout_buf);
-        mbe_initMbeParms(cur_mp, prev_mp, prev_mp_enhanced);
     }
-
-    *err_str = 0;
 }
 
 /// <summary>
@@ -601,13 +622,39 @@ void mbe_processAmbe2450DataF(float* aout_buf, int* errs, int* errs2, char* err_
 /// <param name="prev_mp"></param>
 /// <param name="prev_mp_enhanced"></param>
 /// <param name="uvquality"></param>
-void mbe_processAmbe2450Data(short* aout_buf, int* errs, int* errs2, char* err_str, char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality)
+/// <param name="state"></param>
+void mbe_processAmbe2450Data(short* aout_buf, int* errs, int* errs2, char* err_str, char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality, mbe_state* state)
 {
     float float_buf[160];
-    mbe_processAmbe2450DataF(float_buf, errs, errs2, err_str, ambe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality);
+    mbe_processAmbe2450DataF(float_buf, errs, errs2, err_str, ambe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality, state);
     mbe_floatToShort(float_buf, aout_buf);
 }
 
+/// <summary>
+/// Decodes the model parameters of a 3600x2450 AMBE frame without synthesizing speech.
+/// </summary>
+/// <param name="errs"></param>
+/// <param name="errs2"></param>
+/// <param name="err_str"></param>
+/// <param name="ambe_fr"></param>
+/// <param name="ambe_d"></param>
+/// <param name="cur_mp"></param>
+/// <param name="prev_mp"></param>
+/// <param name="prev_mp_enhanced"></param>
+/// <returns>1 if the frame carries speech, or 0 if the frame should be rendered as silence.</returns>
+int mbe_processAmbe3600x2450FrameParms(int* errs, int* errs2, char* err_str, char ambe_fr[4][24], char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced)
+{
+    *errs = 0;
+    *errs2 = 0;
+    *errs = mbe_eccAmbe3600x2450C0(ambe_fr);
+    mbe_demodulateAmbe3600x2450Data(ambe_fr);
+
+    *errs2 = *errs;
+    *errs2 += mbe_eccAmbe3600x2450Data(ambe_fr, ambe_d);
+
+    return mbe_processAmbe2450Parms(errs, errs2, err_str, ambe_d, cur_mp, prev_mp, prev_mp_enhanced);
+}
+
 /// <summary>
 /// 
 /// </summary>
@@ -621,7 +668,8 @@ void mbe_processAmbe2450Data(short* aout_buf, int* errs, int* errs2, char* err_s
 /// <param name="prev_mp"></param>
 /// <param name="prev_mp_enhanced"></param>
 /// <param name="uvquality"></param>
-void mbe_processAmbe3600x2450FrameF(float* aout_buf, int* errs, int* errs2, char* err_str, char ambe_fr[4][24], char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality)
+/// <param name="state"></param>
+void mbe_processAmbe3600x2450FrameF(float* aout_buf, int* errs, int* errs2, char* err_str, char ambe_fr[4][24], char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality, mbe_state* state)
 {
 
     *errs = 0;
@@ -632,7 +680,7 @@ void mbe_processAmbe3600x2450FrameF(float* aout_buf, int* errs, int* errs2, char
     *errs2 = *errs;
     *errs2 += mbe_eccAmbe3600x2450Data(ambe_fr, ambe_d);
 
-    mbe_processAmbe2450DataF(aout_buf, errs, errs2, err_str, ambe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality);
+    mbe_processAmbe2450DataF(aout_buf, errs, errs2, err_str, ambe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality, state);
 }
 
 /// <summary>
@@ -648,9 +696,10 @@ void mbe_processAmbe3600x2450FrameF(float* aout_buf, int* errs, int* errs2, char
 /// <param name="prev_mp"></param>
 /// <param name="prev_mp_enhanced"></param>
 /// <param name="uvquality"></param>
-void mbe_processAmbe3600x2450Frame(short* aout_buf, int* errs, int* errs2, char* err_str, char ambe_fr[4][24], char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality)
+/// <param name="state"></param>
+void mbe_processAmbe3600x2450Frame(short* aout_buf, int* errs, int* errs2, char* err_str, char ambe_fr[4][24], char ambe_d[49], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality, mbe_state* state)
 {
     float float_buf[160];
-    mbe_processAmbe3600x2450FrameF(float_buf, errs, errs2, err_str, ambe_fr, ambe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality);
+    mbe_processAmbe3600x2450FrameF(float_buf, errs, errs2, err_str, ambe_fr, ambe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality, state);
     mbe_floatToShort(float_buf, aout_buf);
 }
@@ -37,7 +37,7 @@
 /// <param name="block"></param>
 void mbe_checkGolayBlock(long int* block)
 {
-    static int i, syndrome, eccexpected, eccbits, databits;
+    int i, syndrome, eccexpected, eccbits, databits;
     long int mask, block_l;
 
     block_l = *block;
@@ -39,8 +39,8 @@ Word16 saturate(Word32 L_var1);
 // ---------------------------------------------------------------------------
 //  Globals
 // ---------------------------------------------------------------------------
-Flag Overflow = 0;
-Flag Carry = 0;
+thread_local Flag Overflow = 0;
+thread_local Flag Carry = 0;
 
 // ---------------------------------------------------------------------------
 //  Global Functions
@@ -24,8 +24,9 @@
 // ---------------------------------------------------------------------------
 //	 Constants and Globals
 // ---------------------------------------------------------------------------
-extern Flag Overflow;
-extern Flag Carry;
+// the ETSI status flags are per-thread so vocoders may run on separate threads
+extern thread_local Flag Overflow;
+extern thread_local Flag Carry;
 
 #define MAX_32 (Word32)0x7fffffffL
 #define MIN_32 (Word32)0x80000000L
@@ -26,11 +26,255 @@
 #include "vocoder/imbe/tbls.h"
 #include "vocoder/imbe/math_sub.h"
 #include "vocoder/imbe/imbe_vocoder.h"
+#include "vocoder/imbe/simd.h"
+
+#include <math.h>
+#include <string.h>
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+//  Vector butterfly helpers. Each takes the top inputs (x) and the rotated
+//  bottom inputs (t = w * y, exact Q29) widened to 32 bits and computes
+//
+//      top = L_round(L_add(L_shr(L_deposit_h(x), 1), t))
+//      bot = L_round(L_sub(L_shr(L_deposit_h(x), 1), t))
+//
+//  without 32-bit overflow, by splitting x and t around bit 16:
+//  (x << 15) + 0x8000 +/- t == ((x >> 1) +/- (t >> 16)) << 16 + r, with
+//  r = ((x & 1) << 15) + 0x8000 +/- (t & 0xFFFF). The final pack to 16 bits
+//  saturates exactly where L_sub/L_add and L_round would have.
+//-----------------------------------------------------------------------------
+
+#if defined(IMBE_SIMD_SSE2)
+static inline __m128i fft_prod_fix(__m128i p)
+{
+    // L_mult() saturates -32768 * -32768 to 0x7FFFFFFF, which halves to 0x3FFFFFFF
+    return _mm_add_epi32(p, _mm_cmpeq_epi32(p, _mm_set1_epi32(0x40000000)));
+}
+
+static inline void fft_round_sse2(__m128i x, __m128i t, __m128i& top, __m128i& bot)
+{
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i half = _mm_set1_epi32(0x8000);
+    const __m128i low = _mm_set1_epi32(0xFFFF);
+
+    __m128i xs = _mm_srai_epi32(x, 1);
+    __m128i xl = _mm_add_epi32(_mm_slli_epi32(_mm_and_si128(x, one), 15), half);
+    __m128i th = _mm_srai_epi32(t, 16);
+    __m128i tl = _mm_and_si128(t, low);
+
+    top = _mm_add_epi32(_mm_add_epi32(xs, th), _mm_srai_epi32(_mm_add_epi32(xl, tl), 16));
+    bot = _mm_add_epi32(_mm_sub_epi32(xs, th), _mm_srai_epi32(_mm_sub_epi32(xl, tl), 16));
+}
+
+static inline void fft_butterfly_sse2(__m128i& x, __m128i& y, __m128i vwr, __m128i vwi)
+{
+    // real lanes subtract wi * im, imaginary lanes add wi * re
+    const __m128i neg = _mm_setr_epi32(-1, 0, -1, 0);
+
+    __m128i ys = _mm_shufflehi_epi16(_mm_shufflelo_epi16(y, 0xB1), 0xB1);
+
+    __m128i lo = _mm_mullo_epi16(vwr, y), hi = _mm_mulhi_epi16(vwr, y);
+    __m128i p1a = fft_prod_fix(_mm_unpacklo_epi16(lo, hi));
+    __m128i p1b = fft_prod_fix(_mm_unpackhi_epi16(lo, hi));
+
+    lo = _mm_mullo_epi16(vwi, ys);
+    hi = _mm_mulhi_epi16(vwi, ys);
+    __m128i p2a = fft_prod_fix(_mm_unpacklo_epi16(lo, hi));
+    __m128i p2b = fft_prod_fix(_mm_unpackhi_epi16(lo, hi));
+
+    __m128i ta = _mm_add_epi32(p1a, _mm_sub_epi32(_mm_xor_si128(p2a, neg), neg));
+    __m128i tb = _mm_add_epi32(p1b, _mm_sub_epi32(_mm_xor_si128(p2b, neg), neg));
+
+    __m128i xa = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+    __m128i xb = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+
+    __m128i topa, bota, topb, botb;
+    fft_round_sse2(xa, ta, topa, bota);
+    fft_round_sse2(xb, tb, topb, botb);
+
+    x = _mm_packs_epi32(topa, topb);
+    y = _mm_packs_epi32(bota, botb);
+}
+#endif // defined(IMBE_SIMD_SSE2)
+
+#if defined(IMBE_SIMD_AVX2)
+static inline __m256i fft_prod_fix_avx2(__m256i p)
+{
+    return _mm256_add_epi32(p, _mm256_cmpeq_epi32(p, _mm256_set1_epi32(0x40000000)));
+}
+
+static inline void fft_round_avx2(__m256i x, __m256i t, __m256i& top, __m256i& bot)
+{
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i half = _mm256_set1_epi32(0x8000);
+    const __m256i low = _mm256_set1_epi32(0xFFFF);
+
+    __m256i xs = _mm256_srai_epi32(x, 1);
+    __m256i xl = _mm256_add_epi32(_mm256_slli_epi32(_mm256_and_si256(x, one), 15), half);
+    __m256i th = _mm256_srai_epi32(t, 16);
+    __m256i tl = _mm256_and_si256(t, low);
+
+    top = _mm256_add_epi32(_mm256_add_epi32(xs, th), _mm256_srai_epi32(_mm256_add_epi32(xl, tl), 16));
+    bot = _mm256_add_epi32(_mm256_sub_epi32(xs, th), _mm256_srai_epi32(_mm256_sub_epi32(xl, tl), 16));
+}
+
+static inline void fft_butterfly_avx2(__m256i& x, __m256i& y, __m256i vwr, __m256i vwi)
+{
+    // the unpacks and packs below both work within 128-bit lanes, so the
+    // element order comes back out as it went in
+    const __m256i neg = _mm256_setr_epi32(-1, 0, -1, 0, -1, 0, -1, 0);
+
+    __m256i ys = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(y, 0xB1), 0xB1);
+
+    __m256i lo = _mm256_mullo_epi16(vwr, y), hi = _mm256_mulhi_epi16(vwr, y);
+    __m256i p1a = fft_prod_fix_avx2(_mm256_unpacklo_epi16(lo, hi));
+    __m256i p1b = fft_prod_fix_avx2(_mm256_unpackhi_epi16(lo, hi));
+
+    lo = _mm256_mullo_epi16(vwi, ys);
+    hi = _mm256_mulhi_epi16(vwi, ys);
+    __m256i p2a = fft_prod_fix_avx2(_mm256_unpacklo_epi16(lo, hi));
+    __m256i p2b = fft_prod_fix_avx2(_mm256_unpackhi_epi16(lo, hi));
+
+    __m256i ta = _mm256_add_epi32(p1a, _mm256_sub_epi32(_mm256_xor_si256(p2a, neg), neg));
+    __m256i tb = _mm256_add_epi32(p1b, _mm256_sub_epi32(_mm256_xor_si256(p2b, neg), neg));
+
+    __m256i xa = _mm256_srai_epi32(_mm256_unpacklo_epi16(x, x), 16);
+    __m256i xb = _mm256_srai_epi32(_mm256_unpackhi_epi16(x, x), 16);
+
+    __m256i topa, bota, topb, botb;
+    fft_round_avx2(xa, ta, topa, bota);
+    fft_round_avx2(xb, tb, topb, botb);
+
+    x = _mm256_packs_epi32(topa, topb);
+    y = _mm256_packs_epi32(bota, botb);
+}
+#endif // defined(IMBE_SIMD_AVX2)
+
+#if defined(IMBE_SIMD_NEON)
+static inline void fft_round_neon(int32x4_t x, int32x4_t t, int32x4_t& top, int32x4_t& bot)
+{
+    int32x4_t xs = vshrq_n_s32(x, 1);
+    int32x4_t xl = vaddq_s32(vshlq_n_s32(vandq_s32(x, vdupq_n_s32(1)), 15), vdupq_n_s32(0x8000));
+    int32x4_t th = vshrq_n_s32(t, 16);
+    int32x4_t tl = vandq_s32(t, vdupq_n_s32(0xFFFF));
+
+    top = vaddq_s32(vaddq_s32(xs, th), vshrq_n_s32(vaddq_s32(xl, tl), 16));
+    bot = vaddq_s32(vsubq_s32(xs, th), vshrq_n_s32(vsubq_s32(xl, tl), 16));
+}
+
+static inline void fft_butterfly_neon(int16x8_t& x, int16x8_t& y, int16x8_t vwr, int16x8_t vwi)
+{
+    static const int32_t NEG[4] = { -1, 0, -1, 0 };
+    const int32x4_t neg = vld1q_s32(NEG);
+
+    int16x8_t ys = vrev32q_s16(y);
+
+    // vqdmull is L_mult(), saturation included
+    int32x4_t p1a = vshrq_n_s32(vqdmull_s16(vget_low_s16(vwr), vget_low_s16(y)), 1);
+    int32x4_t p1b = vshrq_n_s32(vqdmull_s16(vget_high_s16(vwr), vget_high_s16(y)), 1);
+    int32x4_t p2a = vshrq_n_s32(vqdmull_s16(vget_low_s16(vwi), vget_low_s16(ys)), 1);
+    int32x4_t p2b = vshrq_n_s32(vqdmull_s16(vget_high_s16(vwi), vget_high_s16(ys)), 1);
+
+    int32x4_t ta = vaddq_s32(p1a, vsubq_s32(veorq_s32(p2a, neg), neg));
+    int32x4_t tb = vaddq_s32(p1b, vsubq_s32(veorq_s32(p2b, neg), neg));
+
+    int32x4_t topa, bota, topb, botb;
+    fft_round_neon(vmovl_s16(vget_low_s16(x)), ta, topa, bota);
+    fft_round_neon(vmovl_s16(vget_high_s16(x)), tb, topb, botb);
+
+    x = vcombine_s16(vqmovn_s32(topa), vqmovn_s32(topb));
+    y = vcombine_s16(vqmovn_s32(bota), vqmovn_s32(botb));
+}
+#endif // defined(IMBE_SIMD_NEON)
+
+//-----------------------------------------------------------------------------
+//  Round and saturate a float FFT result back to Word16.
+//-----------------------------------------------------------------------------
+static inline Word16 fft_float_to_word16(float v)
+{
+    v = floorf(v + 0.5f);
+    if (v > 32767.0f)
+        return 32767;
+    if (v < -32768.0f)
+        return -32768;
+    return (Word16)v;
+}
+
+//-----------------------------------------------------------------------------
+//  FFT twiddle tables. They depend only on FFTLENGTH, so one read-only copy
+//  is built on first use and shared by every imbe_vocoder instance.
+//-----------------------------------------------------------------------------
+struct fft_tables {
+    Word16 wr[FFTLENGTH / 2 + 1];
+    Word16 wi[FFTLENGTH / 2 + 1];
+    alignas(32) Word16 tw_re[2 * FFTLENGTH];        // per-stage twiddles for the vector butterflies,
+    alignas(32) Word16 tw_im[2][2 * FFTLENGTH];     // each duplicated for the re and im lanes
+    alignas(32) float tw_fre[FFTLENGTH];
+    alignas(32) float tw_fim[FFTLENGTH];
+
+    fft_tables()
+    {
+        Word16 i, fft_len2, shift, step, theta;
+
+        memset(tw_re, 0, sizeof(tw_re));
+        memset(tw_im, 0, sizeof(tw_im));
+
+        fft_len2 = shr(FFTLENGTH, 1);
+        shift = norm_s(fft_len2);
+        step = shl(2, shift);
+        theta = 0;
+
+        for (i = 0; i <= fft_len2; i++) {
+            wr[i] = cos_fxp(theta);
+            wi[i] = sin_fxp(theta);
+            if (i >= (fft_len2 - 1))
+                theta = ONE_Q15;
+            else
+                theta = add(theta, step);
+        }
+
+        // Twiddles of the vector stages (half-size 4 and up), laid out per stage
+        // in butterfly order; k = 0 is the exact (ONE_Q15, 0) fft() starts with
+        Word16 half, k, base, idx;
+        for (half = 4; half <= fft_len2; half <<= 1) {
+            base = 2 * (half - 4);
+            for (k = 0; k < half; k++) {
+                idx = k * (fft_len2 / half);
+                Word16 re = (k == 0) ? (Word16)ONE_Q15 : wr[idx];
+                Word16 im = (k == 0) ? (Word16)0 : wi[idx];
+                Word16 im_neg = (k == 0) ? (Word16)0 : negate(wi[idx]);
+
+                tw_re[base + 2 * k] = tw_re[base + 2 * k + 1] = re;
+                tw_im[0][base + 2 * k] = tw_im[0][base + 2 * k + 1] = im;
+                tw_im[1][base + 2 * k] = tw_im[1][base + 2 * k + 1] = im_neg;
+            }
+        }
+
+        // Twiddles of the float FFT; stage with half-size h starts at h - 1
+        for (half = 1; half <= fft_len2; half <<= 1) {
+            for (k = 0; k < half; k++) {
+                tw_fre[half - 1 + k] = (float)cos(M_PI * k / half);
+                tw_fim[half - 1 + k] = (float)sin(M_PI * k / half);
+            }
+        }
+    }
+};
+
+static const fft_tables& get_fft_tables(void)
+{
+    static const fft_tables tables;
+    return tables;
+}
 
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
+
 //-----------------------------------------------------------------------------
 //	PURPOSE:
 //				Perform inverse DCT
@@ -136,25 +380,6 @@ void imbe_vocoder::dct(Word16* in, Word16 m_lim, Word16 i_lim, Word16* out)
     }
 }
 
-void imbe_vocoder::fft_init(void)
-{
-    Word16 i, fft_len2, shift, step, theta;
-
-    fft_len2 = shr(FFTLENGTH, 1);
-    shift = norm_s(fft_len2);
-    step = shl(2, shift);
-    theta = 0;
-
-    for (i = 0; i <= fft_len2; i++) {
-        wr_array[i] = cos_fxp(theta);
-        wi_array[i] = sin_fxp(theta);
-        if (i >= (fft_len2 - 1))
-            theta = ONE_Q15;
-        else
-            theta = add(theta, step);
-    }
-}
-
 // Subroutine FFT: Fast Fourier Transform 		
 // ***************************************************************
 // * Replaces data by its DFT, if isign is 1, or replaces data   *
@@ -188,6 +413,12 @@ void imbe_vocoder::fft(Word16* datam1, Word16 nn, Word16 isign)
     Word16* data;
     Word32 L_temp1, L_temp2;
     Word16 index, index_step;
+    const fft_tables& tables = get_fft_tables();
+
+    if (fft_mode == IMBE_FFT_FLOAT) {
+        fft_float(datam1, nn, isign);
+        return;
+    }
 
     //  Use pointer indexed from 1 instead of 0	
     data = &datam1[-1];
@@ -217,6 +448,15 @@ void imbe_vocoder::fft(Word16* datam1, Word16 nn, Word16 isign)
         index = 0;
         index_step = shr(index_step, 1);
 
+#if defined(IMBE_SIMD)
+        // Run the stage on vectors when the twiddle tables fit the length
+        if (nn == FFTLENGTH) {
+            fft_stage_simd(datam1, nn, shr(mmax, 1), isign);
+            mmax = istep;
+            continue;
+        }
+#endif
+
         wr = ONE_Q15;
         wi = 0;
         for (m = 1; m < mmax; m += 2) {
@@ -249,12 +489,221 @@ void imbe_vocoder::fft(Word16* datam1, Word16 nn, Word16 isign)
                 data[i + 1] = L_round(L_add(L_temp1, L_tempi));
             }
             index = add(index, index_step);
-            wr = wr_array[index];
+            wr = tables.wr[index];
             if (isign < 0)
-                wi = negate(wi_array[index]);
+                wi = negate(tables.wi[index]);
             else
-                wi = wi_array[index];
+                wi = tables.wi[index];
         }
         mmax = istep;
     }
 }
+
+//-----------------------------------------------------------------------------
+//	PURPOSE:
+//				Perform one FFT stage on vectors, producing the same
+//				results as the scalar butterflies in fft()
+//
+//  INPUT:
+//              datam1 -  complex data, bit reversed, Q14
+//              nn     -  FFT length (FFTLENGTH)
+//              half   -  butterflies per group
+//              isign  -  1 for the forward transform, -1 for the inverse
+//
+//	OUTPUT:
+//		None
+//
+//	RETURN:
+//		        Saved in datam1 result of the stage
+//
+//-----------------------------------------------------------------------------
+void imbe_vocoder::fft_stage_simd(Word16* datam1, Word16 nn, Word16 half, Word16 isign)
+{
+#if defined(IMBE_SIMD)
+    const fft_tables& tables = get_fft_tables();
+    Word16 i, group, k;
+
+    if (half < 4) {
+        // Groups are narrower than a vector; gather the tops of four
+        // butterflies (from two or four groups) into one vector and the
+        // bottoms into another, and scatter them back afterwards
+        Word16 tw_re = ONE_Q15, tw_im = 0;
+        if (half == 2) {
+            tw_re = tables.wr[FFTLENGTH / 4];
+            tw_im = (isign < 0) ? negate(tables.wi[FFTLENGTH / 4]) : tables.wi[FFTLENGTH / 4];
+        }
+
+#if defined(IMBE_SIMD_SSE2)
+        const __m128i vwr = (half == 2) ? _mm_setr_epi16(ONE_Q15, ONE_Q15, tw_re, tw_re, ONE_Q15, ONE_Q15, tw_re, tw_re) : _mm_set1_epi16(ONE_Q15);
+        const __m128i vwi = (half == 2) ? _mm_setr_epi16(0, 0, tw_im, tw_im, 0, 0, tw_im, tw_im) : _mm_setzero_si128();
+
+        for (i = 0; i < 2 * nn; i += 16) {
+            __m128i g0 = _mm_loadu_si128((const __m128i*)&datam1[i]);
+            __m128i g1 = _mm_loadu_si128((const __m128i*)&datam1[i + 8]);
+            if (half == 1) {
+                g0 = _mm_shuffle_epi32(g0, 0xD8);
+                g1 = _mm_shuffle_epi32(g1, 0xD8);
+            }
+
+            __m128i x = _mm_unpacklo_epi64(g0, g1);
+            __m128i y = _mm_unpackhi_epi64(g0, g1);
+            fft_butterfly_sse2(x, y, vwr, vwi);
+
+            if (half == 1) {
+                g0 = _mm_unpacklo_epi32(x, y);
+                g1 = _mm_unpackhi_epi32(x, y);
+            }
+            else {
+                g0 = _mm_unpacklo_epi64(x, y);
+                g1 = _mm_unpackhi_epi64(x, y);
+            }
+
+            _mm_storeu_si128((__m128i*)&datam1[i], g0);
+            _mm_storeu_si128((__m128i*)&datam1[i + 8], g1);
+        }
+#elif defined(IMBE_SIMD_NEON)
+        const Word16 w_re[8] = { ONE_Q15, ONE_Q15, tw_re, tw_re, ONE_Q15, ONE_Q15, tw_re, tw_re };
+        const Word16 w_im[8] = { 0, 0, tw_im, tw_im, 0, 0, tw_im, tw_im };
+        const int16x8_t vwr = (half == 2) ? vld1q_s16(w_re) : vdupq_n_s16(ONE_Q15);
+        const int16x8_t vwi = (half == 2) ? vld1q_s16(w_im) : vdupq_n_s16(0);
+
+        for (i = 0; i < 2 * nn; i += 16) {
+            int16x8_t g0 = vld1q_s16(&datam1[i]);
+            int16x8_t g1 = vld1q_s16(&datam1[i + 8]);
+
+            int16x8_t x, y;
+            if (half == 1) {
+                int32x4x2_t uz = vuzpq_s32(vreinterpretq_s32_s16(g0), vreinterpretq_s32_s16(g1));
+                x = vreinterpretq_s16_s32(uz.val[0]);
+                y = vreinterpretq_s16_s32(uz.val[1]);
+            }
+            else {
+                x = vcombine_s16(vget_low_s16(g0), vget_low_s16(g1));
+                y = vcombine_s16(vget_high_s16(g0), vget_high_s16(g1));
+            }
+
+            fft_butterfly_neon(x, y, vwr, vwi);
+
+            if (half == 1) {
+                int32x4x2_t zp = vzipq_s32(vreinterpretq_s32_s16(x), vreinterpretq_s32_s16(y));
+                g0 = vreinterpretq_s16_s32(zp.val[0]);
+                g1 = vreinterpretq_s16_s32(zp.val[1]);
+            }
+            else {
+                g0 = vcombine_s16(vget_low_s16(x), vget_low_s16(y));
+                g1 = vcombine_s16(vget_high_s16(x), vget_high_s16(y));
+            }
+
+            vst1q_s16(&datam1[i], g0);
+            vst1q_s16(&datam1[i + 8], g1);
+        }
+#endif
+        return;
+    }
+
+    const Word16* tw_re = &tables.tw_re[2 * (half - 4)];
+    const Word16* tw_im = &tables.tw_im[(isign < 0) ? 1 : 0][2 * (half - 4)];
+
+    for (group = 0; group < nn; group += 2 * half) {
+        Word16* a = &datam1[2 * group];
+        Word16* b = &datam1[2 * (group + half)];
+
+        k = 0;
+#if defined(IMBE_SIMD_AVX2)
+        for (; k + 8 <= half; k += 8) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)&a[2 * k]);
+            __m256i y = _mm256_loadu_si256((const __m256i*)&b[2 * k]);
+            fft_butterfly_avx2(x, y, _mm256_loadu_si256((const __m256i*)&tw_re[2 * k]), _mm256_loadu_si256((const __m256i*)&tw_im[2 * k]));
+            _mm256_storeu_si256((__m256i*)&a[2 * k], x);
+            _mm256_storeu_si256((__m256i*)&b[2 * k], y);
+        }
+#endif
+#if defined(IMBE_SIMD_SSE2)
+        for (; k < half; k += 4) {
+            __m128i x = _mm_loadu_si128((const __m128i*)&a[2 * k]);
+            __m128i y = _mm_loadu_si128((const __m128i*)&b[2 * k]);
+            fft_butterfly_sse2(x, y, _mm_loadu_si128((const __m128i*)&tw_re[2 * k]), _mm_loadu_si128((const __m128i*)&tw_im[2 * k]));
+            _mm_storeu_si128((__m128i*)&a[2 * k], x);
+            _mm_storeu_si128((__m128i*)&b[2 * k], y);
+        }
+#elif defined(IMBE_SIMD_NEON)
+        for (; k < half; k += 4) {
+            int16x8_t x = vld1q_s16(&a[2 * k]);
+            int16x8_t y = vld1q_s16(&b[2 * k]);
+            fft_butterfly_neon(x, y, vld1q_s16(&tw_re[2 * k]), vld1q_s16(&tw_im[2 * k]));
+            vst1q_s16(&a[2 * k], x);
+            vst1q_s16(&b[2 * k], y);
+        }
+#endif
+    }
+#endif // defined(IMBE_SIMD)
+}
+
+//-----------------------------------------------------------------------------
+//	PURPOSE:
+//				Perform the FFT in single precision; each stage scales
+//				by one half like the fixed-point butterflies, and the
+//				result is rounded and saturated back to Q14
+//
+//  INPUT:
+//              datam1 -  complex data, Q14
+//              nn     -  FFT length (power of two, up to FFTLENGTH)
+//              isign  -  1 for the forward transform, -1 for the inverse
+//
+//	OUTPUT:
+//		None
+//
+//	RETURN:
+//		        Saved in datam1 result of the transform
+//
+//-----------------------------------------------------------------------------
+void imbe_vocoder::fft_float(Word16* datam1, Word16 nn, Word16 isign)
+{
+    const fft_tables& tables = get_fft_tables();
+    float re[FFTLENGTH], im[FFTLENGTH];
+    const float sign = (isign < 0) ? -1.0f : 1.0f;
+    Word16 i, j, m, half, group, k;
+
+    // load in bit reversed order
+    j = 0;
+    for (i = 0; i < nn; i++) {
+        re[j] = (float)datam1[2 * i];
+        im[j] = (float)datam1[2 * i + 1];
+
+        m = nn >> 1;
+        while (m >= 1 && (j & m)) {
+            j ^= m;
+            m >>= 1;
+        }
+        j |= m;
+    }
+
+    for (half = 1; half < nn; half <<= 1) {
+        const float* tw_re = &tables.tw_fre[half - 1];
+        const float* tw_im = &tables.tw_fim[half - 1];
+
+        for (group = 0; group < nn; group += 2 * half) {
+            float* ar = &re[group];
+            float* ai = &im[group];
+            float* br = &re[group + half];
+            float* bi = &im[group + half];
+
+            for (k = 0; k < half; k++) {
+                float wi = sign * tw_im[k];
+                float tr = tw_re[k] * br[k] - wi * bi[k];
+                float ti = tw_re[k] * bi[k] + wi * br[k];
+
+                br[k] = ar[k] - tr;
+                bi[k] = ai[k] - ti;
+                ar[k] += tr;
+                ai[k] += ti;
+            }
+        }
+    }
+
+    const float scale = 1.0f / (float)nn;
+    for (i = 0; i < nn; i++) {
+        datam1[2 * i] = fft_float_to_word16(re[i] * scale);
+        datam1[2 * i + 1] = fft_float_to_word16(im[i] * scale);
+    }
+}
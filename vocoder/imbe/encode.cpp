@@ -42,7 +42,6 @@ void imbe_vocoder::encode_init(void)
     v_zap(pitch_ref_buf, PITCH_EST_BUF_SIZE);
     v_zap(pe_lpf_mem, PE_LPF_ORD);
     pitch_est_init();
-    fft_init();
     dc_rmv_mem = 0;
     sa_encode_init();
     pitch_ref_init();
@@ -50,6 +49,7 @@ void imbe_vocoder::encode_init(void)
 
 void imbe_vocoder::encode(IMBE_PARAM* imbe_param, Word16* frame_vector, Word16* snd)
 {
+    Cmplx16 fft_buf[FFTLENGTH];
     Word16 i;
     Word16* wr_ptr, *sig_ptr;
 
@@ -89,3 +89,71 @@ void imbe_vocoder::encode(IMBE_PARAM* imbe_param, Word16* frame_vector, Word16*
     sa_encode(imbe_param);
     encode_frame_vector(imbe_param, frame_vector);
 }
+
+void imbe_vocoder::encode_param(IMBE_PARAM* imbe_param, Word16* frame_vector, const IMBE_PARAM* src)
+{
+    Word16 i, band, first, last, cnt, shift, tmp, ref_pitch, num_harms, num_bands, b1_vec, uv_harms_cnt;
+
+    // Pitch is refined in 1/8 sample steps over 19.875 - 123.125
+    ref_pitch = src->ref_pitch;
+    if (ref_pitch < 0x13E0)
+        ref_pitch = 0x13E0;
+    else if (ref_pitch > 0x7B20)
+        ref_pitch = 0x7B20;
+    ref_pitch = add(ref_pitch, 0x0010) & 0xFFE0;
+
+    shift = norm_s(ref_pitch);
+    tmp = shl(ref_pitch, shift);
+    tmp = div_s(0x4000, tmp);
+
+    imbe_param->ref_pitch = ref_pitch;
+    imbe_param->fund_freq = L_shl(tmp, shift + 11);
+
+    // Harmonic and band count follow the same rules as v_uv_det()
+    tmp = shr(add(shr(ref_pitch, 1), CNST_0_25_Q8_8), 8);
+    num_harms = extract_h((UWord32)CNST_0_9254_Q0_16 * tmp);
+    if (num_harms < NUM_HARMS_MIN)
+        num_harms = NUM_HARMS_MIN;
+    else if (num_harms > NUM_HARMS_MAX)
+        num_harms = NUM_HARMS_MAX;
+
+    if (num_harms <= 36)
+        num_bands = extract_h((UWord32)(num_harms + 2) * CNST_0_33_Q0_16);
+    else
+        num_bands = NUM_BANDS_MAX;
+
+    imbe_param->num_harms = num_harms;
+    imbe_param->num_bands = num_bands;
+
+    // Harmonics share the fundamental, so source harmonic i maps onto harmonic i;
+    // harmonics beyond the source's last repeat it
+    for (i = 0; i < num_harms; i++)
+        imbe_param->sa[i] = src->sa[(i < src->num_harms) ? i : src->num_harms - 1];
+
+    // Voicing is decided per band by majority of the source harmonics in it
+    b1_vec = 0;
+    uv_harms_cnt = 0;
+    for (band = 0; band < num_bands; band++) {
+        first = band * 3;
+        last = (band == num_bands - 1) ? num_harms : first + 3;
+
+        cnt = 0;
+        for (i = first; i < last; i++)
+            cnt += src->v_uv_dsn[(i < src->num_harms) ? i : src->num_harms - 1] ? 1 : 0;
+
+        v_uv_dsn[band] = (2 * cnt >= last - first) ? 1 : 0;
+        b1_vec = (b1_vec << 1) | v_uv_dsn[band];
+
+        for (i = first; i < last; i++)
+            imbe_param->v_uv_dsn[i] = v_uv_dsn[band];
+        if (!v_uv_dsn[band])
+            uv_harms_cnt += last - first;
+    }
+
+    imbe_param->l_uv = uv_harms_cnt;
+    imbe_param->b_vec[1] = b1_vec;
+    imbe_param->b_vec[0] = shr(sub(ref_pitch, 0x1380), 7);
+
+    sa_encode(imbe_param);
+    encode_frame_vector(imbe_param, frame_vector);
+}
@@ -28,26 +28,46 @@
 //  Public Class Members
 // ---------------------------------------------------------------------------
 
-imbe_vocoder::imbe_vocoder(void) :
+imbe_vocoder::imbe_vocoder(imbe_fft_mode fft_mode) : imbe_vocoder(pristine())
+{
+    this->fft_mode = fft_mode;
+}
+
+void imbe_vocoder::reset(void)
+{
+    imbe_fft_mode mode = fft_mode;
+    float gain_adjust = d_gain_adjust;
+
+    *this = pristine();
+
+    fft_mode = mode;
+    d_gain_adjust = gain_adjust;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+imbe_vocoder::imbe_vocoder(pristine_tag) :
     prev_pitch(0),
     prev_prev_pitch(0),
     prev_e_p(0),
     prev_prev_e_p(0),
+    e_p_next_cnt(0),
     seed(1),
     num_harms_prev1(0),
     num_harms_prev2(0),
     num_harms_prev3(0),
     fund_freq_prev(0),
     th_max(0),
+    fft_mode(IMBE_FFT_FIXED),
     dc_rmv_mem(0),
     d_gain_adjust(0)
 {
-    memset(wr_array, 0, sizeof(wr_array));
-    memset(wi_array, 0, sizeof(wi_array));
+    memset(e_p_next, 0, sizeof(e_p_next));
     memset(pitch_est_buf, 0, sizeof(pitch_est_buf));
     memset(pitch_ref_buf, 0, sizeof(pitch_ref_buf));
     memset(pe_lpf_mem, 0, sizeof(pe_lpf_mem));
-    memset(fft_buf, 0, sizeof(fft_buf));
     memset(sa_prev1, 0, sizeof(sa_prev1));
     memset(sa_prev2, 0, sizeof(sa_prev2));
     memset(uv_mem, 0, sizeof(uv_mem));
@@ -61,3 +81,9 @@ imbe_vocoder::imbe_vocoder(void) :
     decode_init(&my_imbe_param);
     encode_init();
 }
+
+const imbe_vocoder& imbe_vocoder::pristine(void)
+{
+    static const imbe_vocoder state((pristine_tag()));
+    return state;
+}
@@ -28,6 +28,16 @@
 #include "vocoder/imbe/basic_op.h"
 #include "vocoder/imbe/math_sub.h"
 
+// ---------------------------------------------------------------------------
+//	Constants
+// ---------------------------------------------------------------------------
+
+// FFT arithmetic used for speech analysis
+enum imbe_fft_mode {
+	IMBE_FFT_FIXED,		// saturating fixed-point, bit-exact with the reference
+	IMBE_FFT_FLOAT		// single precision, rounded back to fixed-point
+};
+
 // ---------------------------------------------------------------------------
 //	Class Declaration
 //		
@@ -35,7 +45,7 @@
 
 class imbe_vocoder {
 public:
-	imbe_vocoder(void);
+	imbe_vocoder(imbe_fft_mode fft_mode = IMBE_FFT_FIXED);
 	~imbe_vocoder() { }
 
 	// imbe_encode compresses 160 samples (in unsigned int format)
@@ -45,6 +55,14 @@ public:
 		encode(&my_imbe_param, frame_vector, snd);
 	}
 	
+	// imbe_encode_param quantizes externally supplied model parameters
+	// (ref_pitch, num_harms, v_uv_dsn and sa of param), skipping speech
+	// analysis; outputs u[] vectors as frame_vector[]
+	void imbe_encode_param(int16_t *frame_vector, const IMBE_PARAM *param)
+	{
+		encode_param(&my_imbe_param, frame_vector, param);
+	}
+
 	// imbe_decode decodes IMBE codewords (frame_vector),
 	// outputs the resulting 160 audio samples (snd)
 	void imbe_decode(int16_t *frame_vector, int16_t *snd)
@@ -56,11 +74,24 @@ public:
 	const IMBE_PARAM* param(void) { return &my_imbe_param; }
 	void set_gain_adjust(float gain_adjust) { d_gain_adjust = gain_adjust; }
 
+	// reset returns the encoder and decoder history to the freshly
+	// constructed state; the FFT mode and gain adjustment are kept
+	void reset(void);
+
 private:
+	// tag selecting the constructor that runs the *_init routines
+	struct pristine_tag { };
+	imbe_vocoder(pristine_tag);
+
+	// fully initialized state every instance is copied from
+	static const imbe_vocoder& pristine(void);
+
 	IMBE_PARAM my_imbe_param;
 
 	/* data items originally static (moved from individual c++ sources) */
 	Word16 prev_pitch, prev_prev_pitch, prev_e_p, prev_prev_e_p;
+	Word16 e_p_next[2][203];		// E(p) of the next frames, from the last look-ahead
+	Word16 e_p_next_cnt;
 	UWord32 seed;
 	Word16 num_harms_prev1;
 	Word32 sa_prev1[NUM_HARMS_MAX + 2];
@@ -74,21 +105,21 @@ private:
 	Word16 sa_prev3[NUM_HARMS_MAX];
 	Word32 th_max;
 	Word16 v_uv_dsn[NUM_BANDS_MAX];
-	Word16 wr_array[FFTLENGTH / 2 + 1];
-	Word16 wi_array[FFTLENGTH / 2 + 1];
+	imbe_fft_mode fft_mode;
 	Word16 pitch_est_buf[PITCH_EST_BUF_SIZE];
 	Word16 pitch_ref_buf[PITCH_EST_BUF_SIZE];
 	Word32 dc_rmv_mem;
-	Cmplx16 fft_buf[FFTLENGTH];
 	Word16 pe_lpf_mem[PE_LPF_ORD];
 	float d_gain_adjust;
 
 	/* member functions */
 	void idct(Word16 *in, Word16 m_lim, Word16 i_lim, Word16 *out);
 	void dct(Word16 *in, Word16 m_lim, Word16 i_lim, Word16 *out);
-	void fft_init(void);
 	void fft(Word16 *datam1, Word16 nn, Word16 isign);
+	void fft_stage_simd(Word16 *datam1, Word16 nn, Word16 half, Word16 isign);
+	void fft_float(Word16 *datam1, Word16 nn, Word16 isign);
 	void encode(IMBE_PARAM *imbe_param, Word16 *frame_vector, Word16 *snd);
+	void encode_param(IMBE_PARAM *imbe_param, Word16 *frame_vector, const IMBE_PARAM *src);
 	void pitch_est_init(void);
 	Word32 autocorr(Word16 *sigin, Word16 shift, Word16 scale_shift);
 	void e_p(Word16 *sigin, Word16 *res_buf);
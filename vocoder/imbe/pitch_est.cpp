@@ -28,6 +28,9 @@
 #include "vocoder/imbe/tbls.h"
 #include "vocoder/imbe/pitch_est.h"
 #include "vocoder/imbe/imbe_vocoder.h"
+#include "vocoder/imbe/simd.h"
+
+#include <string.h>
 
 #if defined(__GNUC__) || defined(__GNUG__)
 #pragma GCC diagnostic ignored "-Wunused-but-set-variable"
@@ -62,6 +65,127 @@ static const UWord16 min_max_tbl[203] =
     0x98ca, 0x99ca, 0x9aca
 };
 
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+//	PURPOSE:
+//				Check whether autocorr_fast() may be used for a signal
+//
+//  INPUT:
+//              sigin       -  pointer to PITCH_EST_FRAME input samples
+//              scale_shift -  scaling applied to each product (0 or 5)
+//
+//	RETURN:
+//		        True if no partial sum of any autocorrelation of the
+//		        signal can saturate. The sum of |L_mult(a, b)| over any
+//		        shift is at most the sum of L_mult(a, a), and the scaling
+//		        rounds each term down by less than one
+//
+//-----------------------------------------------------------------------------
+static bool autocorr_fits(const Word16* sigin, Word16 scale_shift)
+{
+    int64_t sum = 0;
+    for (Word16 i = 0; i < PITCH_EST_FRAME; i++)
+        sum += 2 * (int64_t)sigin[i] * sigin[i];
+
+    return (sum >> scale_shift) + PITCH_EST_FRAME < (int64_t)MAX_32;
+}
+
+//-----------------------------------------------------------------------------
+//	PURPOSE:
+//				Calculate autocorr() without saturation
+//
+//  INPUT:
+//              sigin       -  pointer to PITCH_EST_FRAME input samples
+//              shift       -  time shift
+//              scale_shift -  scaling applied to each product (0 or 5)
+//
+//	RETURN:
+//		        The same sum as autocorr(), provided autocorr_fits()
+//
+//-----------------------------------------------------------------------------
+static Word32 autocorr_fast(const Word16* sigin, Word16 shift, Word16 scale_shift)
+{
+    const Word16* sigsh = &sigin[shift];
+    Word16 len = PITCH_EST_FRAME - shift;
+    Word16 i = 0;
+    Word32 sum = 0;
+
+    // L_shr(L_mult(a, b), 5) is (a * b) >> 4; with no scaling the doubling
+    // is applied to the whole sum
+#if defined(IMBE_SIMD_AVX2)
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 16 <= len; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)&sigin[i]);
+        __m256i b = _mm256_loadu_si256((const __m256i*)&sigsh[i]);
+        if (scale_shift == 0) {
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(a, b));
+        }
+        else {
+            __m256i lo = _mm256_mullo_epi16(a, b), hi = _mm256_mulhi_epi16(a, b);
+            acc = _mm256_add_epi32(acc, _mm256_srai_epi32(_mm256_unpacklo_epi16(lo, hi), 4));
+            acc = _mm256_add_epi32(acc, _mm256_srai_epi32(_mm256_unpackhi_epi16(lo, hi), 4));
+        }
+    }
+
+    Word32 lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    for (Word16 n = 0; n < 8; n++)
+        sum += lanes[n];
+#elif defined(IMBE_SIMD_SSE2)
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 8 <= len; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i*)&sigin[i]);
+        __m128i b = _mm_loadu_si128((const __m128i*)&sigsh[i]);
+        if (scale_shift == 0) {
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(a, b));
+        }
+        else {
+            __m128i lo = _mm_mullo_epi16(a, b), hi = _mm_mulhi_epi16(a, b);
+            acc = _mm_add_epi32(acc, _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 4));
+            acc = _mm_add_epi32(acc, _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 4));
+        }
+    }
+
+    Word32 lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    for (Word16 n = 0; n < 4; n++)
+        sum += lanes[n];
+#elif defined(IMBE_SIMD_NEON)
+    int32x4_t acc = vdupq_n_s32(0);
+    for (; i + 8 <= len; i += 8) {
+        int16x8_t a = vld1q_s16(&sigin[i]);
+        int16x8_t b = vld1q_s16(&sigsh[i]);
+        int32x4_t plo = vmull_s16(vget_low_s16(a), vget_low_s16(b));
+        int32x4_t phi = vmull_s16(vget_high_s16(a), vget_high_s16(b));
+        if (scale_shift == 0) {
+            acc = vaddq_s32(acc, vaddq_s32(plo, phi));
+        }
+        else {
+            acc = vaddq_s32(acc, vshrq_n_s32(plo, 4));
+            acc = vaddq_s32(acc, vshrq_n_s32(phi, 4));
+        }
+    }
+
+    Word32 lanes[4];
+    vst1q_s32(lanes, acc);
+    for (Word16 n = 0; n < 4; n++)
+        sum += lanes[n];
+#endif
+
+    if (scale_shift == 0) {
+        for (; i < len; i++)
+            sum += (Word32)sigin[i] * sigsh[i];
+        return sum * 2;
+    }
+
+    for (; i < len; i++)
+        sum += ((Word32)sigin[i] * sigsh[i]) >> (scale_shift - 1);
+    return sum;
+}
+
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
@@ -70,6 +194,7 @@ void imbe_vocoder::pitch_est_init(void)
 {
     prev_pitch = prev_prev_pitch = 158; // 100
     prev_e_p = prev_prev_e_p = 0;
+    e_p_next_cnt = 0;
 }
 
 Word32 imbe_vocoder::autocorr(Word16* sigin, Word16 shift, Word16 scale_shift)
@@ -113,14 +238,22 @@ void imbe_vocoder::e_p(Word16* sigin, Word16* res_buf)
     else
         scale_shift = 0;
 
-    L_e0 = 0;
-    for (i = 0; i < PITCH_EST_FRAME; i++)
-        L_e0 = L_add(L_e0, L_shr(L_mult(sig_wndwed[i], sig_wndwed[i]), scale_shift));              // sum(s^2 * wi^4) 
+    // Correlations are summed without saturation when none can saturate; the
+    // zero shift correlation is sum(s^2 * wi^4)
+    if (autocorr_fits(sig_wndwed, scale_shift)) {
+        L_e0 = autocorr_fast(sig_wndwed, 0, scale_shift);
 
-    // Calculate correlation for time shift in range 21...150 with step 0.5
-    // For integer shifts
-    for (tmp = 21, i = 0; tmp <= 150; tmp++, i += 2)
-        corr[i] = autocorr(sig_wndwed, tmp, scale_shift);
+        // Calculate correlation for time shift in range 21...150 with step 0.5
+        // For integer shifts
+        for (tmp = 21, i = 0; tmp <= 150; tmp++, i += 2)
+            corr[i] = autocorr_fast(sig_wndwed, tmp, scale_shift);
+    }
+    else {
+        L_e0 = autocorr(sig_wndwed, 0, scale_shift);
+
+        for (tmp = 21, i = 0; tmp <= 150; tmp++, i += 2)
+            corr[i] = autocorr(sig_wndwed, tmp, scale_shift);
+    }
     // For intermediate shifts
     for (i = 1; i < 258; i += 2)
         corr[i] = L_shr(L_add(corr[i - 1], corr[i + 1]), 1);
@@ -185,8 +318,13 @@ void imbe_vocoder::pitch_est(IMBE_PARAM* imbe_param, Word16* frames_buf)
     Word16 cef_est, cef, p0_est, p0, p1, p2, p1_max_index, p2_max_index, e1p1_e2p2_est, e1p1_e2p2;
     Word16 e_p_arr2_min[203];
 
-    // Calculate E(p) function for current and two future frames
-    e_p(&frames_buf[0], e_p_arr0);
+    // Calculate E(p) function for current and two future frames; the buffer
+    // moves by one frame per call, so E(p) of frames that were look-ahead
+    // frames last time is reused
+    if (e_p_next_cnt > 0)
+        memcpy(e_p_arr0, e_p_next[0], sizeof(e_p_arr0));
+    else
+        e_p(&frames_buf[0], e_p_arr0);
 
     // Look-Back Pitch Tracking
     min_index = HI_BYTE(min_max_tbl[prev_pitch]);
@@ -203,6 +341,13 @@ void imbe_vocoder::pitch_est(IMBE_PARAM* imbe_param, Word16* frames_buf)
 
 
     if (ceb <= CNST_0_48_Q4_12) {
+        if (e_p_next_cnt > 1) {
+            memcpy(e_p_next[0], e_p_next[1], sizeof(e_p_next[0]));
+            e_p_next_cnt = 1;
+        }
+        else
+            e_p_next_cnt = 0;
+
         prev_prev_pitch = prev_pitch;
         prev_pitch = pb;
         prev_prev_e_p = prev_e_p;
@@ -215,9 +360,16 @@ void imbe_vocoder::pitch_est(IMBE_PARAM* imbe_param, Word16* frames_buf)
 
 
     // Look-Ahead Pitch Tracking
-    e_p(&frames_buf[FRAME], e_p_arr1);
+    if (e_p_next_cnt > 1)
+        memcpy(e_p_arr1, e_p_next[1], sizeof(e_p_arr1));
+    else
+        e_p(&frames_buf[FRAME], e_p_arr1);
     e_p(&frames_buf[2 * FRAME], e_p_arr2);
 
+    memcpy(e_p_next[0], e_p_arr1, sizeof(e_p_next[0]));
+    memcpy(e_p_next[1], e_p_arr2, sizeof(e_p_next[1]));
+    e_p_next_cnt = 2;
+
     p0_est = p0 = 0;
     cef_est = e_p_arr0[p0] + e_p_arr1[p0] + e_p_arr2[p0];
     e1p1_e2p2 = 1;
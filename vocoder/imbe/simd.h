@@ -0,0 +1,50 @@
+/**
+* Digital Voice Modem - Transcode Software
+* GPLv2 Open Source. Use is subject to license terms.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* @package DVM / Transcode Software
+*
+*/
+/*
+*   Copyright (C) 2022 by Bryan Biedenkapp N2PLL
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+#ifndef __IMBE_SIMD_H__
+#define __IMBE_SIMD_H__
+
+// ---------------------------------------------------------------------------
+//	Vector instruction set used by the fixed-point kernels. Every kernel
+//	guarded by these reproduces the saturating basic_op arithmetic it
+//	replaces bit for bit.
+// ---------------------------------------------------------------------------
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define IMBE_SIMD
+#define IMBE_SIMD_AVX2
+#define IMBE_SIMD_SSE2
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define IMBE_SIMD
+#define IMBE_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define IMBE_SIMD
+#define IMBE_SIMD_NEON
+#endif
+
+#endif // __IMBE_SIMD_H__
@@ -34,7 +34,6 @@
 
 void imbe_vocoder::uv_synt_init(void)
 {
-    fft_init();
     v_zap(uv_mem, 105);
 }
 
@@ -434,9 +434,10 @@ void mbe_demodulateImbe7200x4400Data(char imbe[8][23])
 }
 
 /// <summary>
-/// 
+/// Decodes the model parameters of a 4400 bps IMBE frame without synthesizing speech.
 /// </summary>
-/// <param name="aout_buf"></param>
+/// <remarks>On return cur_mp holds the enhanced parameters of the frame; the caller is expected
+/// to move them into prev_mp_enhanced once it has finished with them.</remarks>
 /// <param name="errs"></param>
 /// <param name="errs2"></param>
 /// <param name="err_str"></param>
@@ -444,8 +445,8 @@ void mbe_demodulateImbe7200x4400Data(char imbe[8][23])
 /// <param name="cur_mp"></param>
 /// <param name="prev_mp"></param>
 /// <param name="prev_mp_enhanced"></param>
-/// <param name="uvquality"></param>
-void mbe_processImbe4400DataF(float* aout_buf, int* errs, int* errs2, char* err_str, char imbe_d[88], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality)
+/// <returns>1 if the frame carries speech, or 0 if the frame should be rendered as silence.</returns>
+int mbe_processImbe4400Parms(int* errs, int* errs2, char* err_str, char imbe_d[88], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced)
 {
     int i, bad;
 
@@ -468,16 +469,39 @@ void mbe_processImbe4400DataF(float* aout_buf, int* errs, int* errs2, char* err_
     if (cur_mp->repeat <= 3) {
         mbe_moveMbeParms(cur_mp, prev_mp);
         mbe_spectralAmpEnhance(cur_mp);
-        mbe_synthesizeSpeechf(aout_buf, cur_mp, prev_mp_enhanced, uvquality);
+        *err_str = 0;
+        return 1;
+    }
+
+    *err_str = 'M';
+    err_str++;
+    mbe_initMbeParms(cur_mp, prev_mp, prev_mp_enhanced);
+    *err_str = 0;
+    return 0;
+}
+
+/// <summary>
+/// 
+/// </summary>
+/// <param name="aout_buf"></param>
+/// <param name="errs"></param>
+/// <param name="errs2"></param>
+/// <param name="err_str"></param>
+/// <param name="imbe_d"></param>
+/// <param name="cur_mp"></param>
+/// <param name="prev_mp"></param>
+/// <param name="prev_mp_enhanced"></param>
+/// <param name="uvquality"></param>
+/// <param name="state"></param>
+void mbe_processImbe4400DataF(float* aout_buf, int* errs, int* errs2, char* err_str, char imbe_d[88], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality, mbe_state* state)
+{
+    if (mbe_processImbe4400Parms(errs, errs2, err_str, imbe_d, cur_mp, prev_mp, prev_mp_enhanced)) {
+        mbe_synthesizeSpeechf(aout_buf, cur_mp, prev_mp_enhanced, uvquality, state);
         mbe_moveMbeParms(cur_mp, prev_mp_enhanced);
     }
     else {
-        *err_str = 'M';
-        err_str++;
         mbe_synthesizeSilenceF(aout_buf);
-        mbe_initMbeParms(cur_mp, prev_mp, prev_mp_enhanced);
     }
-    *err_str = 0;
 }
 
 /// <summary>
@@ -492,10 +516,11 @@ void mbe_processImbe4400DataF(float* aout_buf, int* errs, int* errs2, char* err_
 /// <param name="prev_mp"></param>
 /// <param name="prev_mp_enhanced"></param>
 /// <param name="uvquality"></param>
-void mbe_processImbe4400Data(short* aout_buf, int* errs, int* errs2, char* err_str, char imbe_d[88], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality)
+/// <param name="state"></param>
+void mbe_processImbe4400Data(short* aout_buf, int* errs, int* errs2, char* err_str, char imbe_d[88], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality, mbe_state* state)
 {
     float float_buf[160];
-    mbe_processImbe4400DataF(float_buf, errs, errs2, err_str, imbe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality);
+    mbe_processImbe4400DataF(float_buf, errs, errs2, err_str, imbe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality, state);
     mbe_floatToShort(float_buf, aout_buf);
 }
 
@@ -512,7 +537,8 @@ void mbe_processImbe4400Data(short* aout_buf, int* errs, int* errs2, char* err_s
 /// <param name="prev_mp"></param>
 /// <param name="prev_mp_enhanced"></param>
 /// <param name="uvquality"></param>
-void mbe_processImbe7200x4400FrameF(float* aout_buf, int* errs, int* errs2, char* err_str, char imbe_fr[8][23], char imbe_d[88], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality)
+/// <param name="state"></param>
+void mbe_processImbe7200x4400FrameF(float* aout_buf, int* errs, int* errs2, char* err_str, char imbe_fr[8][23], char imbe_d[88], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality, mbe_state* state)
 {
     *errs = 0;
     *errs2 = 0;
@@ -521,7 +547,7 @@ void mbe_processImbe7200x4400FrameF(float* aout_buf, int* errs, int* errs2, char
     *errs2 = *errs;
     *errs2 += mbe_eccImbe7200x4400Data(imbe_fr, imbe_d);
 
-    mbe_processImbe4400DataF(aout_buf, errs, errs2, err_str, imbe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality);
+    mbe_processImbe4400DataF(aout_buf, errs, errs2, err_str, imbe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality, state);
 }
 
 /// <summary>
@@ -537,9 +563,10 @@ void mbe_processImbe7200x4400FrameF(float* aout_buf, int* errs, int* errs2, char
 /// <param name="prev_mp"></param>
 /// <param name="prev_mp_enhanced"></param>
 /// <param name="uvquality"></param>
-void mbe_processImbe7200x4400Frame(short* aout_buf, int* errs, int* errs2, char* err_str, char imbe_fr[8][23], char imbe_d[88], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality)
+/// <param name="state"></param>
+void mbe_processImbe7200x4400Frame(short* aout_buf, int* errs, int* errs2, char* err_str, char imbe_fr[8][23], char imbe_d[88], mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced, int uvquality, mbe_state* state)
 {
     float float_buf[160];
-    mbe_processImbe7200x4400FrameF(float_buf, errs, errs2, err_str, imbe_fr, imbe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality);
+    mbe_processImbe7200x4400FrameF(float_buf, errs, errs2, err_str, imbe_fr, imbe_d, cur_mp, prev_mp, prev_mp_enhanced, uvquality, state);
     mbe_floatToShort(float_buf, aout_buf);
 }